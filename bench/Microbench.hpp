@@ -0,0 +1,236 @@
+#ifndef DA_PROJ2_MICROBENCH_HPP
+#define DA_PROJ2_MICROBENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * A minimal, header-only microbenchmark harness, modelled after Google Benchmark: each benchmark is a function that
+ * receives a BenchState, does its setup, and then runs the code being measured inside 'while (state.keepRunning())'.
+ * The number of iterations is increased until a run lasts at least the minimum time, and the time per iteration is
+ * reported for every argument (e.g. graph size) the benchmark was registered with.
+ */
+
+class BenchState {
+/* ATTRIBUTES */
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    long long arg;
+    long long iterations, remaining;
+    long long items;
+
+    Clock::time_point start;
+    Clock::duration elapsed;
+    bool running;
+
+/* CONSTRUCTOR */
+public:
+    /**
+     * @brief creates a new BenchState
+     * @param arg argument of the benchmark (e.g. the size of the graph)
+     * @param iterations number of times the measured code will run
+     */
+    BenchState(long long arg, long long iterations)
+        : arg(arg), iterations(iterations), remaining(iterations), items(0), elapsed(0), running(false) {}
+
+/* METHODS */
+public:
+    /**
+     * @brief returns the argument of the benchmark
+     * @return argument of the benchmark
+     */
+    long long range() const {
+        return arg;
+    }
+
+    /**
+     * @brief starts (on the first call) and keeps the timer running while there are iterations left
+     * @return 'true' if the measured code should run once more, 'false' otherwise
+     */
+    bool keepRunning() {
+        if (!running && remaining == iterations) resumeTiming();
+        if (remaining-- > 0) return true;
+
+        pauseTiming();
+        return false;
+    }
+
+    /**
+     * @brief stops the timer, so that the code that follows (e.g. resetting the input) is not measured
+     */
+    void pauseTiming() {
+        if (!running) return;
+
+        elapsed += Clock::now() - start;
+        running = false;
+    }
+
+    /**
+     * @brief starts the timer again
+     */
+    void resumeTiming() {
+        if (running) return;
+
+        start = Clock::now();
+        running = true;
+    }
+
+    /**
+     * @brief sets the number of items processed by all the iterations, so that the throughput is also reported
+     * @param count number of items
+     */
+    void setItemsProcessed(long long count) {
+        items = count;
+    }
+
+    /**
+     * @brief returns the number of times the measured code runs
+     * @return number of iterations
+     */
+    long long getIterations() const {
+        return iterations;
+    }
+
+    /**
+     * @brief returns the number of items processed by all the iterations
+     * @return number of items (0 if it was not set)
+     */
+    long long getItems() const {
+        return items;
+    }
+
+    /**
+     * @brief returns the time measured so far
+     * @return time (in seconds)
+     */
+    double getSeconds() const {
+        return std::chrono::duration<double>(elapsed).count();
+    }
+};
+
+/**
+ * @brief prevents the compiler from optimizing away a value (and the computation that produced it)
+ * @param value value that must be computed
+ */
+template <typename T>
+inline void doNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief prevents the compiler from assuming that memory is not read or written by the code around it
+ */
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+class Microbench {
+/* ATTRIBUTES */
+private:
+    struct Benchmark {
+        std::string name;
+        std::function<void(BenchState &)> function;
+        std::vector<long long> args;
+    };
+
+/* METHODS */
+private:
+    /**
+     * @brief returns the registered benchmarks
+     * @return reference to the registered benchmarks
+     */
+    static std::vector<Benchmark> &registry() {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+public:
+    /**
+     * @brief registers a benchmark, which is run once for each of its arguments
+     * @param name name of the benchmark
+     * @param function function that runs the benchmark
+     * @param args arguments of the benchmark (e.g. graph sizes)
+     * @return 'true' (so that the registration can initialize a static variable)
+     */
+    static bool add(const std::string &name, std::function<void(BenchState &)> function,
+                    std::vector<long long> args) {
+        registry().push_back({name, std::move(function), std::move(args)});
+        return true;
+    }
+
+    /**
+     * @brief runs every registered benchmark whose name contains the filter, and prints a table with the results
+     * @note accepts '--filter TEXT' and '--min-time SECONDS' (default: 0.5)
+     * @param argc number of arguments
+     * @param argv arguments (the first one being the name of the program)
+     * @return exit status of the program
+     */
+    static int runAll(int argc, char *argv[]) {
+        std::string filter;
+        double minTime = 0.5;
+
+        for (int i = 1; i + 1 < argc; i += 2) {
+            std::string arg = argv[i];
+
+            if (arg == "--filter") filter = argv[i + 1];
+            else if (arg == "--min-time") minTime = atof(argv[i + 1]);
+            else {
+                std::cerr << "Usage: " << argv[0] << " [--filter TEXT] [--min-time SECONDS]" << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << std::left << std::setw(32) << "Benchmark" << std::right << ' ' << std::setw(15) << "Time (ns)"
+                  << ' ' << std::setw(12) << "Iterations" << ' ' << std::setw(15) << "Items/s" << std::endl;
+
+        for (const Benchmark &benchmark : registry()) {
+            if (benchmark.name.find(filter) == std::string::npos) continue;
+
+            for (long long arg : benchmark.args) {
+                std::string name = benchmark.name + '/' + std::to_string(arg);
+                long long iterations = 1;
+
+                // grow the number of iterations until the run lasts long enough to be measured reliably
+                while (true) {
+                    BenchState state(arg, iterations);
+                    benchmark.function(state);
+
+                    double seconds = state.getSeconds();
+
+                    if (seconds >= minTime || iterations >= 1000000000) {
+                        double throughput = seconds > 0 ? (double) state.getItems() / seconds : 0;
+
+                        std::cout << std::left << std::setw(32) << name << std::right << ' ' << std::fixed
+                                  << std::setprecision(1) << std::setw(15) << seconds * 1e9 / (double) iterations
+                                  << ' ' << std::setw(12) << iterations << ' ' << std::defaultfloat
+                                  << std::setprecision(4) << std::setw(15) << throughput << std::endl;
+                        break;
+                    }
+
+                    // aim slightly past the minimum time, but never grow by more than 10 times at once
+                    double factor = seconds > 0 ? 1.4 * minTime / seconds : 10;
+                    iterations = (long long) ((double) iterations * std::min(std::max(factor, 2.0), 10.0));
+                }
+            }
+        }
+
+        return 0;
+    }
+};
+
+#define MICROBENCH_CONCAT_(a, b) a##b
+#define MICROBENCH_CONCAT(a, b) MICROBENCH_CONCAT_(a, b)
+
+// registers a function as a benchmark, e.g. MICROBENCH(haversine, {25, 1000, 100000})
+#define MICROBENCH(function, ...) \
+    static bool MICROBENCH_CONCAT(microbench_, __LINE__) = Microbench::add(#function, function, __VA_ARGS__)
+
+#endif //DA_PROJ2_MICROBENCH_HPP
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Microbench.hpp"
+#include "../src/network/ArrayTour.h"
+#include "../src/network/TSPGraph.h"
+#include "../src/utils/Random.hpp"
+#include "../src/utils/Reader.h"
+
+// sizes of the kernels that are linear in the number of vertices (or lines)
+#define LINEAR_SIZES {25, 100, 1000, 10000, 100000}
+
+// sizes of the kernels that need O(|V|^2) memory (the distance matrix) or time (the local search)
+#define QUADRATIC_SIZES {25, 100, 250, 500, 1000}
+
+/**
+ * @brief adds random places (around mainland Portugal) to a graph, without any edges, so that its distances are
+ * computed with the Haversine formula, like the ones of the Real-Graphs
+ * @param graph graph where the places will be added (which must represent real world locations)
+ * @param n number of places
+ */
+static void addPlaces(TSPGraph &graph, int n) {
+    XorShift rng(n);
+
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(new Place(37 + 5 * rng.nextDouble(), -9 + 3 * rng.nextDouble()));
+}
+
+/**
+ * @brief adds the edges of a complete graph, whose weights are the distances between random points of a square, like
+ * the Extra_Fully_Connected_Graphs
+ * @param graph graph where the edges will be added
+ * @param n number of vertices
+ */
+static void addCompleteEdges(TSPGraph &graph, int n) {
+    XorShift rng(n);
+    std::vector<double> x(n + 1), y(n + 1);
+
+    for (int i = 1; i <= n; ++i) {
+        x[i] = 1e5 * rng.nextDouble();
+        y[i] = 1e5 * rng.nextDouble();
+    }
+
+    graph.resize(n);
+
+    for (int i = 1; i <= n; ++i)
+        for (int j = i + 1; j <= n; ++j)
+            graph.addEdge(i, j, std::round(std::hypot(x[i] - x[j], y[i] - y[j])));
+}
+
+/**
+ * @brief adds the edges of a sparse, connected graph: a ring, along with a few random edges per vertex
+ * @param graph graph where the edges will be added
+ * @param n number of vertices
+ * @param degree number of random edges per vertex
+ */
+static void addSparseEdges(TSPGraph &graph, int n, int degree) {
+    XorShift rng(n);
+    graph.resize(n);
+
+    for (int i = 1; i <= n; ++i) {
+        graph.addEdge(i, i % n + 1, 1 + rng.nextInt(1000));
+
+        for (int k = 0; k < degree; ++k) {
+            int j = 1 + rng.nextInt(n);
+            if (j != i) graph.addEdge(i, j, 1 + rng.nextInt(1000));
+        }
+    }
+}
+
+/**
+ * @brief measures the Haversine formula, over the consecutive pairs of places of a cycle
+ */
+static void haversine(BenchState &state) {
+    int n = (int) state.range();
+    TSPGraph graph(true);
+    addPlaces(graph, n);
+
+    std::vector<const Place *> places;
+    for (int i = 1; i <= n; ++i)
+        places.push_back(&(const Place &) graph[i]);
+
+    while (state.keepRunning()) {
+        double sum = 0;
+
+        for (int i = 0; i < n; ++i)
+            sum += TSPGraph::haversine(*places[i], *places[(i + 1) % n]);
+
+        doNotOptimize(sum);
+    }
+
+    state.setItemsProcessed(state.getIterations() * n);
+}
+
+/**
+ * @brief measures the extraction of the values of the lines of an edges file
+ */
+static void extractValue(BenchState &state) {
+    int n = (int) state.range();
+    XorShift rng(n);
+
+    std::vector<std::string> lines;
+    for (int i = 0; i < n; ++i)
+        lines.push_back(std::to_string(rng.nextInt(n)) + ',' + std::to_string(rng.nextInt(n)) + ','
+                        + std::to_string(1e5 * rng.nextDouble()));
+
+    std::string value;
+
+    while (state.keepRunning()) {
+        for (std::string &line : lines) {
+            auto it = line.begin();
+
+            Reader::extractValue(it, value, ',');
+            Reader::extractValue(it, value, ',');
+            Reader::extractValue(it, value, '\n');
+
+            doNotOptimize(value.data());
+        }
+    }
+
+    state.setItemsProcessed(state.getIterations() * n);
+}
+
+/**
+ * @brief measures the conversion of a complete graph into its adjacency matrix
+ */
+static void toMatrix(BenchState &state) {
+    int n = (int) state.range();
+    TSPGraph graph;
+    addCompleteEdges(graph, n);
+
+    while (state.keepRunning()) {
+        std::vector<std::vector<double>> matrix = graph.toMatrix();
+        doNotOptimize(matrix.data());
+    }
+
+    state.setItemsProcessed(state.getIterations() * n * n);
+}
+
+/**
+ * @brief measures Prim's algorithm, on a sparse graph (as a complete one with 100k vertices would not fit in memory)
+ */
+static void getMST(BenchState &state) {
+    int n = (int) state.range();
+    TSPGraph graph;
+    addSparseEdges(graph, n, 8);
+
+    while (state.keepRunning()) {
+        auto tree = graph.getMST(1);
+        doNotOptimize(tree.size());
+    }
+
+    state.setItemsProcessed(state.getIterations() * graph.countEdges());
+}
+
+/**
+ * @brief measures the 2-opt local search on real world locations, from a tour that visits them from west to east
+ * (the distance matrix is computed beforehand, so only the search itself is measured)
+ */
+static void twoOpt(BenchState &state) {
+    int n = (int) state.range();
+    TSPGraph graph(true);
+    addPlaces(graph, n);
+    graph.getMatrix();
+
+    std::vector<int> order;
+    for (int i = 1; i <= n; ++i)
+        order.push_back(i);
+
+    std::sort(order.begin(), order.end(), [&graph](int lhs, int rhs) {
+        return ((const Place &) graph[lhs]).getLongitude() < ((const Place &) graph[rhs]).getLongitude();
+    });
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        ArrayTour tour(order);
+        double distance = 0;
+        state.resumeTiming();
+
+        graph.twoOpt(tour, distance);
+        doNotOptimize(distance);
+    }
+
+    state.setItemsProcessed(state.getIterations() * n);
+}
+
+MICROBENCH(haversine, LINEAR_SIZES);
+MICROBENCH(extractValue, LINEAR_SIZES);
+MICROBENCH(toMatrix, QUADRATIC_SIZES);
+MICROBENCH(getMST, LINEAR_SIZES);
+MICROBENCH(twoOpt, QUADRATIC_SIZES);
+
+int main(int argc, char *argv[]) {
+    return Microbench::runAll(argc, argv);
+}
@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+#include "Batch.h"
+#include "../parallel/ThreadPool.h"
+#include "../utils/Reader.h"
+#include "../utils/Tracer.h"
+
+using std::cerr;
+using std::endl;
+
+/**
+ * @brief creates a new Batch, which runs the TSP algorithms without any user interaction
+ */
+Batch::Batch() : src(0), timeLimit(0), detectHeader(true), hasHeader(true), tightBound(false), tours(false),
+                 cache(false), profile(false), format(ResultWriter::CSV) {}
+
+/**
+ * @brief prints the command-line options of the batch mode
+ * @param out stream where the options will be printed
+ */
+void Batch::usage(std::ostream &out) {
+    out << "Usage: DA_Proj2 [options] [graph...]" << endl << endl
+        << "Runs the TSP algorithms on each graph (a .csv file or a directory with nodes.csv and edges.csv), without"
+        << endl << "any prompts, and writes the result of each run. Up to one graph per worker thread is solved at"
+        << endl << "once, with the results still written in the order of the graphs. Without arguments, the interactive"
+        << endl << "mode is started." << endl << endl
+        << "Options:" << endl
+        << "  -a, --algorithm NAMES  comma-separated algorithms to run on each graph (default: other), out of:" << endl
+        << "                         backtracking, triangular, other, annealing, tempering, ils, genetic, ants" << endl
+        << "  -s, --source INDEX     index of the source vertex (default: 0)" << endl
+        << "  -t, --time SECONDS     time limit of each run (default: the one of each algorithm)" << endl
+        << "  -j, --jobs FILE        file with one job per line: <graph> <algorithm> [source] [time limit]" << endl
+        << "  -o, --output FILE      file where the results are written (default: the standard output)" << endl
+        << "  -f, --format FORMAT    csv (one line per run, default) or json (one object per line)" << endl
+        << "      --tour             also write the tour of each run" << endl
+        << "      --header           the graph files have a header (by default, it is detected from the first line)"
+        << endl
+        << "      --no-header        the graph files do not have a header" << endl
+        << "      --bound            compute the Held-Karp lower bound of every result (slower)" << endl
+        << "      --cache            reuse the tour of a previous run of the same algorithm on the same graph" << endl
+        << "      --profile          also write the time spent in each phase of each run (JSON only)" << endl
+        << "      --trace FILE       write a timeline of the runs to FILE, as a Chrome trace (which can be opened in"
+        << endl << "                         chrome://tracing or ui.perfetto.dev)" << endl
+        << "      --matrix-cache DIR keep the distance matrices of the two-file graphs (up to 1 GiB each) in DIR, so"
+        << endl << "                         that later runs on them read the matrices rather than compute them" << endl
+        << "      --threads N        number of worker threads (default: one per hardware thread)" << endl
+        << "      --pin              pin each worker thread to its own CPU (out of the ones the process may use)"
+        << endl
+        << "  -h, --help             show this message" << endl;
+}
+
+/**
+ * @brief reads a job file, in which each line contains a graph, an algorithm and, optionally, a source vertex and a
+ * time limit (the ones given as options are used otherwise), and where empty lines and lines starting with '#' are
+ * ignored
+ * @param path path to the job file
+ * @return 'true' if the file was read successfully, 'false' otherwise
+ */
+bool Batch::readJobs(const string &path) {
+    std::ifstream file(path);
+
+    if (!file.is_open()) {
+        cerr << "Could not open the job file '" << path << "'." << endl;
+        return false;
+    }
+
+    string line;
+    for (int lineNumber = 1; getline(file, line); ++lineNumber) {
+        std::istringstream line_(line);
+        Job job = {"", "", src, timeLimit};
+
+        if (!(line_ >> job.graph) || job.graph[0] == '#') continue;
+
+        if (!(line_ >> job.algorithm) || !TSPGraph::isAlgorithm(job.algorithm)) {
+            cerr << path << ':' << lineNumber << ": missing or unknown algorithm." << endl;
+            return false;
+        }
+
+        string extra;
+        if ((line_ >> extra && !Utils::toInt(extra, job.src, 0))
+            || (line_ >> extra && !Utils::toDouble(extra, job.timeLimit, 0))) {
+            cerr << path << ':' << lineNumber << ": invalid source vertex or time limit '" << extra << "'." << endl;
+            return false;
+        }
+
+        jobs.push_back(job);
+    }
+
+    return true;
+}
+
+/**
+ * @brief parses the command-line arguments
+ * @param argc number of arguments
+ * @param argv arguments (the first one being the name of the program)
+ * @note exits the program right away if the help message is requested
+ * @return 'true' if the arguments are valid and there is something to run, 'false' otherwise
+ */
+bool Batch::parse(int argc, char *argv[]) {
+    std::vector<string> graphs, jobFiles;
+    string algorithmList = "other";
+    int threads = 0;
+    bool pinning = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = (i + 1 < argc), valid = true;
+
+        if (arg == "-h" || arg == "--help") {
+            usage(std::cout);
+            exit(0);
+        }
+        else if (arg == "--header" || arg == "--no-header") {
+            detectHeader = false;
+            hasHeader = (arg == "--header");
+        }
+        else if (arg == "--bound") tightBound = true;
+        else if (arg == "--tour") tours = true;
+        else if (arg == "--cache") cache = true;
+        else if (arg == "--profile") profile = true;
+        else if ((arg == "-f" || arg == "--format") && hasValue) {
+            if (!ResultWriter::parseFormat(argv[++i], format)) {
+                cerr << "Unknown format '" << argv[i] << "'." << endl;
+                return false;
+            }
+        }
+        else if ((arg == "-a" || arg == "--algorithm") && hasValue) algorithmList = argv[++i];
+        else if ((arg == "-s" || arg == "--source") && hasValue) valid = Utils::toInt(argv[++i], src, 0);
+        else if ((arg == "-t" || arg == "--time") && hasValue) valid = Utils::toDouble(argv[++i], timeLimit, 0);
+        else if ((arg == "-j" || arg == "--jobs") && hasValue) jobFiles.emplace_back(argv[++i]);
+        else if ((arg == "-o" || arg == "--output") && hasValue) output = argv[++i];
+        else if (arg == "--trace" && hasValue) trace = argv[++i];
+        else if (arg == "--matrix-cache" && hasValue) Reader::setMatrixCache(argv[++i]);
+        else if (arg == "--threads" && hasValue) valid = Utils::toInt(argv[++i], threads, 0);
+        else if (arg == "--pin") pinning = true;
+        else if (!arg.empty() && arg[0] == '-') {
+            cerr << "Invalid option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+        else graphs.push_back(arg);
+
+        if (!valid) {
+            cerr << "Invalid value '" << argv[i] << "' for the option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+    }
+
+    ThreadPool::configure(threads, pinning);
+
+    std::istringstream list(algorithmList);
+    for (string name; getline(list, name, ',');) {
+        if (!TSPGraph::isAlgorithm(name)) {
+            cerr << "Unknown algorithm '" << name << "'." << endl;
+            return false;
+        }
+
+        algorithms.push_back(name);
+    }
+
+    for (const string &graph : graphs)
+        for (const string &algorithm : algorithms)
+            jobs.push_back({graph, algorithm, src, timeLimit});
+
+    for (const string &path : jobFiles)
+        if (!readJobs(path)) return false;
+
+    if ((profile || !trace.empty()) && !Profiler::enabled) {
+        cerr << "This build does not have the instrumentation, so '--profile' and '--trace' are ignored (see "
+             << "PROFILING)." << endl;
+
+        profile = false;
+        trace.clear();
+    }
+
+    if (jobs.empty()) {
+        cerr << "Nothing to run." << endl << endl;
+        usage(cerr);
+    }
+
+    return !jobs.empty();
+}
+
+/**
+ * @brief runs a job on a graph that has already been loaded and writes its result
+ * @param graph graph where the algorithm will be executed
+ * @param job job to be run
+ * @param load time it took to load the graph (in milliseconds)
+ * @param loading what was recorded while the graph was loaded, which is part of the breakdown of every run
+ * @param writer ResultWriter where the result will be written
+ * @return 'true' if the job was run (even if it timed out), 'false' otherwise
+ */
+bool Batch::runJob(TSPGraph &graph, const Job &job, long long load, const Profiler::Report &loading,
+                   ResultWriter &writer) const {
+    ResultWriter::Record record = {job.graph, job.algorithm, "ok", job.src, graph.countVertices(), 0, 0, 0, load,
+                                   nullptr, nullptr};
+
+    if (job.src < 0 || job.src >= graph.countVertices()) {
+        record.status = "invalid_source";
+        writer.write(record);
+
+        return false;
+    }
+
+    Progress progress;
+    Profiler::Report before = Profiler::snapshot();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    Tour tour = graph.solve(job.algorithm, job.src + 1, job.timeLimit, progress,
+                            cache ? &SolutionCache::shared() : nullptr);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    record.time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    record.length = tour.hasDistances() ? tour.getLength() : 0;
+    record.bound = progress.snapshot().bound;
+    record.tour = tour.hasDistances() ? &tour : nullptr;
+
+    if (progress.isCancelled()) record.status = "timeout";
+    else if (tightBound && record.length > 0 && record.bound < record.length)
+        record.bound = std::max(record.bound, graph.lowerBound(HeldKarp::Config(), record.length));
+
+    Profiler::Report report = loading + (Profiler::snapshot() - before);
+    if (profile) record.profile = &report;
+
+    writer.write(record);
+
+    // once the run is over, so that writing the cache file is not counted as part of it
+    graph.persistMatrix();
+
+    return true;
+}
+
+/**
+ * @brief loads a graph and runs its jobs on it, in the order they were given, writing their results
+ * @param path path to the graph
+ * @param jobs jobs to be run on the graph
+ * @param writer ResultWriter where the results will be written
+ * @return 'true' if every job was run, 'false' otherwise
+ */
+bool Batch::runGraph(const string &path, const std::vector<const Job *> &jobs, ResultWriter &writer) const {
+    TSPGraph graph;
+    string error;
+
+    Profiler::Report before = Profiler::snapshot();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (access(path.c_str(), 0) == -1) error = "missing_graph";
+    else {
+        try {
+            graph = Reader().read(path, detectHeader ? Reader::detectHeader(path) : hasHeader);
+        }
+        catch (const std::exception &) {
+            error = "invalid_graph";
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    long long load = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    Profiler::Report loading = Profiler::snapshot() - before;
+
+    bool res = true;
+
+    for (const Job *job : jobs) {
+        if (error.empty()) {
+            if (!runJob(graph, *job, load, loading, writer)) res = false;
+        }
+        else {
+            writer.write({job->graph, job->algorithm, error, job->src, 0, 0, 0, 0, load, nullptr, nullptr});
+            res = false;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief runs every job, loading each graph only once (the jobs of the same graph are run together, in the order they
+ * were given), and writes their results
+ * @note the graphs are solved concurrently, each on its own thread and at most one per worker of the shared
+ * ThreadPool at once (or one at a time if the breakdown of each run is written, as the Profiler is process-wide), so
+ * that only the parallel parts of the algorithms go to the ThreadPool, where a solve can never run nested in another;
+ * the results are still written in the order of the graphs
+ * @return exit status of the program (0 if every job was run, 1 otherwise)
+ */
+int Batch::run() {
+    int fd = STDOUT_FILENO;
+
+    if (!output.empty()) {
+        fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd == -1) {
+            cerr << "Could not open the output file '" << output << "'." << endl;
+            return 1;
+        }
+    }
+
+    ResultWriter writer(fd, format, tours);
+    writer.writeHeader();
+
+    if (!trace.empty()) Tracer::start();
+
+    // group the jobs by graph, keeping the order in which each graph first appears
+    std::vector<string> graphs;
+    std::map<string, std::vector<const Job *>> jobsOf;
+
+    for (const Job &job : jobs) {
+        if (!jobsOf.count(job.graph)) graphs.push_back(job.graph);
+        jobsOf[job.graph].push_back(&job);
+    }
+
+    size_t count = graphs.size();
+    std::vector<string> results(count);
+    std::vector<char> done(count, false), failed(count, false);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> stopped(false);
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    auto solveGraphs = [&]() {
+        for (size_t g = next++; g < count && !stopped; g = next++) {
+            string result;
+            ResultWriter graphWriter(result, format, tours);
+
+            bool ran = runGraph(graphs[g], jobsOf.at(graphs[g]), graphWriter);
+            graphWriter.flush();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            results[g] = std::move(result);
+            failed[g] = !ran;
+            done[g] = true;
+
+            finished.notify_all();
+        }
+    };
+
+    size_t concurrency = profile ? 1 : std::min((size_t) ThreadPool::shared().size(), count);
+    std::vector<std::thread> solvers;
+
+    for (size_t t = 0; t < concurrency; ++t)
+        solvers.emplace_back(solveGraphs);
+
+    int status = 0;
+
+    for (size_t g = 0; g < count; ++g) {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]() { return done[g]; });
+
+        string result = std::move(results[g]);
+        if (failed[g]) status = 1;
+
+        lock.unlock();
+
+        // write out the results of each graph as soon as they (and the ones before them) are known, stopping once the
+        // output fails
+        writer.append(result);
+
+        if (!writer.flush()) {
+            stopped = true;
+            break;
+        }
+    }
+
+    for (std::thread &solver : solvers)
+        solver.join();
+
+    if (!writer.flush()) {
+        cerr << "Could not write the results to '" << (output.empty() ? "the standard output" : output) << "'." << endl;
+        status = 1;
+    }
+
+    if (fd != STDOUT_FILENO && close(fd) != 0) status = 1;
+
+    if (!trace.empty()) {
+        Tracer::stop();
+
+        if (!Tracer::dump(trace)) {
+            cerr << "Could not write the trace to '" << trace << "'." << endl;
+            status = 1;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,51 @@
+#ifndef DA_PROJ2_BATCH_H
+#define DA_PROJ2_BATCH_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../network/TSPGraph.h"
+#include "../utils/Profiler.h"
+#include "../utils/Progress.h"
+#include "../utils/ResultWriter.h"
+
+using std::string;
+
+class Batch {
+/* ATTRIBUTES */
+private:
+    struct Job {
+        string graph;
+        string algorithm;
+        int src;                // index of the source vertex (as shown to the user, i.e. starting at 0)
+        double timeLimit;       // in seconds (0 uses the default of the algorithm)
+    };
+
+    std::vector<Job> jobs;
+    std::vector<string> algorithms;
+    int src;
+    double timeLimit;
+    bool detectHeader, hasHeader;   // hasHeader is only used if the header is not detected (--header/--no-header)
+    bool tightBound, tours, cache, profile;
+    string output, trace;   // trace is the file where the timeline of the runs is written (empty if it is not)
+    ResultWriter::Format format;
+
+/* CONSTRUCTOR */
+public:
+    Batch();
+
+/* METHODS */
+private:
+    static void usage(std::ostream &out);
+    bool readJobs(const string &path);
+    bool runJob(TSPGraph &graph, const Job &job, long long load, const Profiler::Report &loading,
+                ResultWriter &writer) const;
+    bool runGraph(const string &path, const std::vector<const Job *> &jobs, ResultWriter &writer) const;
+
+public:
+    bool parse(int argc, char *argv[]);
+    int run();
+};
+
+#endif //DA_PROJ2_BATCH_H
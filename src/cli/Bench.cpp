@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "Bench.h"
+#include "../parallel/ThreadPool.h"
+#include "../utils/Reader.h"
+
+using std::cerr;
+using std::endl;
+
+// the bundled datasets, along with whether their files have a header
+const std::vector<Bench::Dataset> Bench::datasets = {{"Toy-Graphs", true}, {"Extra_Fully_Connected_Graphs", false}};
+
+/**
+ * @brief creates a new Bench, which measures the TSP algorithms on the bundled datasets
+ */
+Bench::Bench() : dataPath("data"), algorithms({"triangular", "other"}), warmups(1), repetitions(5), timeLimit(0) {}
+
+/**
+ * @brief prints the command-line options of the benchmark mode
+ * @param out stream where the options will be printed
+ */
+void Bench::usage(std::ostream &out) {
+    out << "Usage: DA_Proj2 --bench [options]" << endl << endl
+        << "Runs the TSP algorithms on every graph of the bundled datasets (Toy-Graphs and" << endl
+        << "Extra_Fully_Connected_Graphs), and reports the median and 95th percentile of their wall time, the length"
+        << endl << "of their tours and the time it took to load each graph, as a table and (optionally) as CSV." << endl
+        << endl
+        << "Options:" << endl
+        << "  -d, --data DIRECTORY   directory where the datasets are (default: data)" << endl
+        << "  -a, --algorithm NAMES  comma-separated algorithms to measure (default: triangular,other), out of:" << endl
+        << "                         backtracking, triangular, other, annealing, tempering, ils, genetic, ants" << endl
+        << "  -w, --warmups N        runs of each algorithm that are not measured (default: 1)" << endl
+        << "  -r, --repetitions N    runs of each algorithm that are measured (default: 5)" << endl
+        << "  -t, --time SECONDS     time limit of each run (default: the one of each algorithm)" << endl
+        << "  -o, --output FILE      file where the results are also written, as CSV" << endl
+        << "      --threads N        number of worker threads (default: one per hardware thread)" << endl
+        << "      --pin              pin each worker thread to its own CPU (out of the ones the process may use)"
+        << endl
+        << "  -h, --help             show this message" << endl;
+}
+
+/**
+ * @brief lists the graphs of a dataset, i.e. its .csv files and its subdirectories (which hold the two-file graphs)
+ * @param directory path to the dataset
+ * @return paths to the graphs, with the smaller ones (by the length of their names, e.g. edges_25 before edges_100)
+ * first
+ */
+std::vector<string> Bench::listGraphs(const string &directory) {
+    std::vector<string> graphs;
+
+    DIR *dir = opendir(directory.c_str());
+    if (!dir) return graphs;
+
+    for (dirent *entry = readdir(dir); entry; entry = readdir(dir)) {
+        string name = entry->d_name;
+        if (name.empty() || name[0] == '.') continue;
+
+        bool isCSV = (name.size() > 4 && name.substr(name.size() - 4) == ".csv");
+        if (isCSV || entry->d_type == DT_DIR) graphs.push_back(name);
+    }
+
+    closedir(dir);
+
+    std::sort(graphs.begin(), graphs.end(), [](const string &lhs, const string &rhs) {
+        return (lhs.size() != rhs.size()) ? lhs.size() < rhs.size() : lhs < rhs;
+    });
+
+    for (string &graph : graphs)
+        graph = directory + '/' + graph;
+
+    return graphs;
+}
+
+/**
+ * @brief computes a percentile of a sample, using the nearest-rank method
+ * @complexity O(n * log(n))
+ * @param values sample
+ * @param p percentile (between 0 and 1, with 0.5 being the median)
+ * @return value of the percentile (0 if the sample is empty)
+ */
+double Bench::percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+
+    std::sort(values.begin(), values.end());
+    auto rank = (size_t) std::ceil(p * (double) values.size());
+
+    return values[std::max(rank, (size_t) 1) - 1];
+}
+
+/**
+ * @brief loads a graph as many times as each algorithm is run, and measures how long it takes
+ * @param path path to the graph
+ * @param hasHeader indicates if the files of the graph have a header
+ * @param graph TSPGraph where the graph will be stored
+ * @param load where the median load time (in milliseconds) will be stored
+ * @return 'true' if the graph was loaded, 'false' otherwise
+ */
+bool Bench::loadGraph(const string &path, bool hasHeader, TSPGraph &graph, double &load) const {
+    std::vector<double> times;
+
+    for (int i = 0; i < warmups + repetitions; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        try {
+            graph = Reader().read(path, hasHeader);
+        }
+        catch (const std::exception &) {
+            return false;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        if (i >= warmups) times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    load = percentile(times, 0.5);
+    return graph.countVertices() > 0;
+}
+
+/**
+ * @brief runs an algorithm on a graph, first without measuring it (which also builds the distance matrix, so that
+ * only the algorithm itself is measured afterwards) and then measuring the wall time of each run
+ * @param graph graph where the algorithm will be executed
+ * @param name name of the graph, as shown in the results
+ * @param algorithm name of the algorithm
+ * @param load median time it took to load the graph (in milliseconds)
+ * @return measurements of the algorithm
+ */
+Bench::Result Bench::measure(TSPGraph &graph, const string &name, const string &algorithm, double load) const {
+    Result result = {name, algorithm, graph.countVertices(), load, 0, 0, 0, 0};
+    std::vector<double> times, lengths;
+
+    for (int i = 0; i < warmups + repetitions; ++i) {
+        Progress progress;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        Tour tour = graph.solve(algorithm, 1, timeLimit, progress);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (i < warmups) continue;
+
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        if (tour.hasDistances()) lengths.push_back(tour.getLength());
+        if (progress.isCancelled()) ++result.timeouts;
+    }
+
+    result.median = percentile(times, 0.5);
+    result.p95 = percentile(times, 0.95);
+    result.length = percentile(lengths, 0.5);
+
+    return result;
+}
+
+/**
+ * @brief prints the results as a table
+ * @param results measurements of every algorithm on every graph
+ */
+void Bench::printTable(const std::vector<Result> &results) {
+    fort::char_table table = Utils::createTable({"Graph", "Algorithm", "Vertices", "Load (ms)", "Median (ms)",
+                                                 "P95 (ms)", "Length", "Timeouts"});
+
+    for (const Result &result : results) {
+        std::ostringstream load, median, p95, length;
+
+        load << std::fixed << std::setprecision(3) << result.load;
+        median << std::fixed << std::setprecision(3) << result.median;
+        p95 << std::fixed << std::setprecision(3) << result.p95;
+        length << std::fixed << std::setprecision(2) << result.length;
+
+        table << result.graph << result.algorithm << result.vertices << load.str() << median.str() << p95.str()
+              << (result.length > 0 ? length.str() : "-") << result.timeouts << fort::endr;
+    }
+
+    std::cout << table.to_string() << endl;
+}
+
+/**
+ * @brief writes the results to the output file, as CSV
+ * @param results measurements of every algorithm on every graph
+ * @return 'true' if the file was written, 'false' otherwise
+ */
+bool Bench::writeCSV(const std::vector<Result> &results) const {
+    std::ofstream out(output);
+    if (!out.is_open()) return false;
+
+    out << "graph,algorithm,vertices,warmups,repetitions,load_ms,median_ms,p95_ms,length,timeouts" << endl
+        << std::fixed;
+
+    for (const Result &result : results) {
+        out << '"' << result.graph << "\"," << result.algorithm << ',' << result.vertices << ',' << warmups << ','
+            << repetitions << ',' << std::setprecision(3) << result.load << ',' << result.median << ',' << result.p95
+            << ',';
+
+        if (result.length > 0) out << std::setprecision(2) << result.length;
+        out << ',' << result.timeouts << '\n';
+    }
+
+    out.close();
+    return !out.fail();
+}
+
+/**
+ * @brief parses the command-line arguments of the benchmark mode
+ * @param argc number of arguments
+ * @param argv arguments (the first one being the name of the program)
+ * @note exits the program right away if the help message is requested
+ * @return 'true' if the arguments are valid, 'false' otherwise
+ */
+bool Bench::parse(int argc, char *argv[]) {
+    string algorithmList;
+    int threads = 0;
+    bool pinning = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = (i + 1 < argc), valid = true;
+
+        if (arg == "-h" || arg == "--help") {
+            usage(std::cout);
+            exit(0);
+        }
+        else if (arg == "--bench") continue;
+        else if ((arg == "-d" || arg == "--data") && hasValue) dataPath = argv[++i];
+        else if ((arg == "-a" || arg == "--algorithm") && hasValue) algorithmList = argv[++i];
+        else if ((arg == "-w" || arg == "--warmups") && hasValue) valid = Utils::toInt(argv[++i], warmups, 0);
+        else if ((arg == "-r" || arg == "--repetitions") && hasValue) valid = Utils::toInt(argv[++i], repetitions, 1);
+        else if ((arg == "-t" || arg == "--time") && hasValue) valid = Utils::toDouble(argv[++i], timeLimit, 0);
+        else if ((arg == "-o" || arg == "--output") && hasValue) output = argv[++i];
+        else if (arg == "--threads" && hasValue) valid = Utils::toInt(argv[++i], threads, 0);
+        else if (arg == "--pin") pinning = true;
+        else {
+            cerr << "Invalid option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+
+        if (!valid) {
+            cerr << "Invalid value '" << argv[i] << "' for the option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+    }
+
+    ThreadPool::configure(threads, pinning);
+    if (algorithmList.empty()) return true;
+    algorithms.clear();
+
+    std::istringstream list(algorithmList);
+    for (string name; getline(list, name, ',');) {
+        if (!TSPGraph::isAlgorithm(name)) {
+            cerr << "Unknown algorithm '" << name << "'." << endl;
+            return false;
+        }
+
+        algorithms.push_back(name);
+    }
+
+    return true;
+}
+
+/**
+ * @brief measures every algorithm on every graph of the bundled datasets (starting at vertex 0, and without the
+ * SolutionCache, so that every run is computed), reporting the progress to the standard error
+ * @return exit status of the program (0 if every graph was measured, 1 otherwise)
+ */
+int Bench::run() {
+    std::vector<Result> results;
+    int status = 0;
+
+    for (const Dataset &dataset : datasets) {
+        std::vector<string> graphs = listGraphs(dataPath + '/' + dataset.directory);
+
+        if (graphs.empty()) {
+            cerr << "No graphs were found in '" << dataPath << '/' << dataset.directory << "'." << endl;
+            status = 1;
+        }
+
+        for (const string &path : graphs) {
+            string name = path.substr(dataPath.size() + 1);
+            TSPGraph graph;
+            double load;
+
+            if (!loadGraph(path, dataset.hasHeader, graph, load)) {
+                cerr << "Could not load '" << path << "'." << endl;
+                status = 1;
+
+                continue;
+            }
+
+            for (const string &algorithm : algorithms) {
+                cerr << "Measuring " << algorithm << " on " << name << "..." << endl;
+                results.push_back(measure(graph, name, algorithm, load));
+            }
+        }
+    }
+
+    printTable(results);
+
+    if (!output.empty() && !writeCSV(results)) {
+        cerr << "Could not write the results to '" << output << "'." << endl;
+        status = 1;
+    }
+
+    return status;
+}
@@ -0,0 +1,56 @@
+#ifndef DA_PROJ2_BENCH_H
+#define DA_PROJ2_BENCH_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../network/TSPGraph.h"
+
+using std::string;
+
+class Bench {
+/* ATTRIBUTES */
+private:
+    struct Dataset {
+        string directory;       // relative to the data directory
+        bool hasHeader;
+    };
+
+    struct Result {
+        string graph, algorithm;
+        int vertices;
+        double load;            // median load time (in milliseconds)
+        double median, p95;     // wall time of the runs (in milliseconds)
+        double length;          // median length of the tours (0 if no tour was found)
+        int timeouts;           // number of runs that were cut short by the time limit
+    };
+
+    static const std::vector<Dataset> datasets;
+
+    string dataPath, output;
+    std::vector<string> algorithms;
+    int warmups, repetitions;
+    double timeLimit;
+
+/* CONSTRUCTOR */
+public:
+    Bench();
+
+/* METHODS */
+private:
+    static void usage(std::ostream &out);
+    static std::vector<string> listGraphs(const string &directory);
+    static double percentile(std::vector<double> values, double p);
+
+    bool loadGraph(const string &path, bool hasHeader, TSPGraph &graph, double &load) const;
+    Result measure(TSPGraph &graph, const string &name, const string &algorithm, double load) const;
+    static void printTable(const std::vector<Result> &results);
+    bool writeCSV(const std::vector<Result> &results) const;
+
+public:
+    bool parse(int argc, char *argv[]);
+    int run();
+};
+
+#endif //DA_PROJ2_BENCH_H
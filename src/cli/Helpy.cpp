@@ -1,6 +1,11 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <fcntl.h>
+#include <iomanip>
+#include <poll.h>
+#include <sys/stat.h>
 #include <unistd.h>
-#include <thread>
 
 #include "Helpy.h"
 
@@ -25,14 +30,20 @@ std::map<string, int> Helpy::command = {{"change", 1}, {"run", 2}, {"execute", 2
 
 std::map<string, int> Helpy::target = {{"selected", 3}, {"current", 3},  {"curr", 3}, {"backtracking", 6},
                                        {"backtrack", 6}, {"triangular", 9}, {"triangle", 9}, {"other", 12},
-                                       {"our", 12}, {"multithreading", 15}, {"threads", 15}, {"loading", 15}};
+                                       {"our", 12}, {"multithreading", 15}, {"threads", 15}, {"loading", 15},
+                                       {"annealing", 100}, {"anneal", 100}, {"tempering", 200},
+                                       {"iterated", 300}, {"ils", 300},
+                                       {"genetic", 400}, {"ants", 500}, {"colony", 500},
+                                       {"cache", 600}, {"bound", 700}};
 
-std::map<string, int> Helpy::what = {{"graph", 5}, {"tsp", 10}, {"source", 15}, {"src", 15}};
+std::map<string, int> Helpy::what = {{"graph", 5}, {"tsp", 10}, {"source", 15}, {"src", 15}, {"format", 1000},
+                                     {"output", 1000}};
 
 /**
  * @brief creates a new Helpy object
  */
-Helpy::Helpy() : reader(), pathToRoot("../"), src(1), multithreading(true), loading(false) {
+Helpy::Helpy() : reader(), pathToRoot("../"), src(1), multithreading(true), cache(false), tightBound(false),
+                 format("table"), loading() {
     fetchData("../data/Toy-Graphs/tourism.csv", true);
 }
 
@@ -42,7 +53,12 @@ Helpy::Helpy() : reader(), pathToRoot("../"), src(1), multithreading(true), load
  * @param twoFiles indicates if the data is split into two files (edges.csv and nodes.csv) or not
  */
 void Helpy::fetchData(const string& path, bool hasHeader) {
+    Profiler::Report before = Profiler::snapshot();
+
     graph = reader.read(path, hasHeader);
+    graphPath = path;
+
+    loading = Profiler::snapshot() - before;
 }
 
 /**
@@ -140,7 +156,8 @@ b1: cout << BREAK;
     std::cin >> s2;
     Utils::lowercase(s2);
 
-    if (target[s1] == target["toggle"] && target[s2] == target["multithreading"])
+    if (target[s1] == target["toggle"] && (target[s2] == target["multithreading"] || target[s2] == target["cache"]
+                                           || target[s2] == target["bound"]))
         goto p1;
 
     std::cin >> s3;
@@ -195,10 +212,17 @@ b2: cout << BREAK;
         cout << "* Backtracking" << endl;
         cout << "* Triangular" << endl;
         cout << "* Other" << endl;
+        cout << "* Annealing" << endl;
+        cout << "* Tempering" << endl;
+        cout << "* Iterated" << endl;
+        cout << "* Genetic" << endl;
+        cout << "* Colony" << endl;
     }
     else if (s1 == "toggle") {
         cout << BREAK;
         cout << "* Multithreading" << endl;
+        cout << "* Cache" << endl;
+        cout << "* Bound" << endl;
     }
     else if (s1 == "quit" || s1 == "die") {
         goto e2;
@@ -216,12 +240,16 @@ b2: cout << BREAK;
         cout << BREAK;
         if (s1 != "display") cout << "* Graph" << endl;
         cout << "* Source" << endl;
+        cout << "* Format" << endl;
     }
-    else if ((s2 == "approximation") || (s2 == "backtracking") || (s2 == "other")) {
+    else if ((s2 == "approximation") || (s2 == "backtracking") || (s2 == "triangular") || (s2 == "other") ||
+             (s2 == "annealing") || (s2 == "tempering") ||
+             (s2 == "iterated") || (s2 == "genetic") ||
+             (s2 == "colony")) {
         cout << BREAK;
         cout << "* TSP" << endl;
     }
-    else if (s2 == "multithreading") {
+    else if (s2 == "multithreading" || s2 == "cache" || s2 == "bound") {
         goto p1;
     }
     else if (s2 == "quit" || s2 == "die") {
@@ -297,6 +325,42 @@ bool Helpy::processCommand(string& s1, string& s2, string& s3){
             runAlgorithm(3);
             break;
         }
+        case (112) : {
+            runAlgorithm(4);
+            break;
+        }
+        case (212) : {
+            runAlgorithm(5);
+            break;
+        }
+        case (312) : {
+            runAlgorithm(6);
+            break;
+        }
+        case (412) : {
+            runAlgorithm(7);
+            break;
+        }
+        case (512) : {
+            runAlgorithm(8);
+            break;
+        }
+        case (608) : {
+            toggleCache();
+            break;
+        }
+        case (708) : {
+            toggleBound();
+            break;
+        }
+        case (1004) : {
+            changeCurrentFormat();
+            break;
+        }
+        case (1007) : {
+            displayCurrentFormat();
+            break;
+        }
         default : {
             cout << BREAK;
             cout << RED << "Invalid command! Please, type another command." << RESET << endl;
@@ -324,97 +388,223 @@ void Helpy::terminal(){
  * @brief prints a table which represents a solution to the TSP
  * @param path solution to the TSP to be printed
  */
-void Helpy::printPath(std::list<std::pair<int, double>> &path) {
+void Helpy::printPath(const Tour &path) {
+    PROFILE_SCOPE(OUTPUT);
     fort::char_table table = Utils::createTable({"N", "Source", "Destination", "Distance", "Total Distance"});
 
-    int prev = path.back().first - 1, n = 1;
-    double totalDistance = 0;
+    for (int i = 0; path.hasDistances() && i < path.size(); ++i) {
+        table << i + 1 << (path[i] - 1) << (path[(i + 1) % path.size()] - 1) << path.getDistance(i)
+              << path.getCumulativeDistance(i) << fort::endr;
+    }
+
+    cout << table.to_string() << endl;
+    cout << BOLD << "Total distance: " << YELLOW << path.getLength() << " m" << RESET << endl;
+}
+
+/**
+ * @brief writes a solution to the TSP in the current format (CSV or JSON), streaming it, along with a summary of the
+ * run, to the output file (appending to it) or to the terminal
+ * @param path solution to the TSP to be written
+ * @param n number that indicates which algorithm computed the solution
+ * @param duration execution time of the algorithm (in milliseconds)
+ * @param bound lower bound on the length of the optimal tour (0 if unknown)
+ * @param cancelled indicates if the algorithm was cancelled
+ * @param profile breakdown of the run (only written as JSON, and only if the instrumentation was built)
+ * @return 'true' if the results were written, 'false' otherwise
+ */
+bool Helpy::writeResult(const Tour &path, int n, long long duration, double bound, bool cancelled,
+                        const Profiler::Report &profile) const {
+    PROFILE_SCOPE(OUTPUT);
+
+    ResultWriter::Format resultFormat;
+    ResultWriter::parseFormat(format, resultFormat);
+
+    int fd = STDOUT_FILENO;
+    bool header = true;
 
-    for (auto &p : path) {
-        totalDistance += p.second;
-        table << n++ << prev << (p.first - 1) << p.second << totalDistance
-              << fort::endr;
+    if (!outputPath.empty()) {
+        fd = open(outputPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd == -1) return false;
 
-        prev = p.first - 1;
+        // the header is only written at the start of the file
+        struct stat info = {};
+        header = (fstat(fd, &info) == 0 && info.st_size == 0);
     }
+    else cout << std::flush;
 
-    cout << table.to_string() << endl;
-    cout << BOLD << "Total distance: " << YELLOW << totalDistance << " m" << RESET << endl;
+    bool written;
+
+    {
+        ResultWriter writer(fd, resultFormat, true);
+        if (header) writer.writeHeader();
+
+        writer.write({graphPath, TSPGraph::algorithms()[n - 1], cancelled ? "cancelled" : "ok", src - 1,
+                      graph.countVertices(), path.hasDistances() ? path.getLength() : 0, bound, duration, 0,
+                      path.hasDistances() ? &path : nullptr, Profiler::enabled ? &profile : nullptr});
+
+        written = writer.flush();
+    }
+
+    if (fd != STDOUT_FILENO) close(fd);
+    return written;
 }
 
 /**
- * @brief prints a loading screen
+ * @brief prints the breakdown of a run, i.e. the time spent in each of its phases (including the loading of the
+ * graph) and the value of each counter, unless nothing was recorded (e.g. without the instrumentation)
+ * @param profile breakdown of the run
  */
-void Helpy::printLoadingScreen() const {
+void Helpy::printProfile(const Profiler::Report &profile) {
+    if (profile.empty()) return;
+
+    cout << BOLD << "Breakdown:" << RESET << endl;
+
+    for (int i = 0; i < Profiler::PHASES; ++i) {
+        auto phase = (Profiler::Phase) i;
+        if (!profile.calls[phase]) continue;
+
+        std::ostringstream time;
+        time << std::fixed << std::setprecision(3) << profile.milliseconds(phase) << " ms";
+
+        cout << "  " << Profiler::label(phase) << ": " << YELLOW << time.str() << RESET;
+        if (profile.calls[phase] > 1) cout << " (" << profile.calls[phase] << " calls)";
+
+        cout << endl;
+    }
+
+    for (int i = 0; i < Profiler::COUNTERS; ++i) {
+        auto counter = (Profiler::Counter) i;
+        if (profile.counts[counter])
+            cout << "  " << Profiler::label(counter) << ": " << YELLOW << profile.counts[counter] << RESET << endl;
+    }
+}
+
+/**
+ * @brief prints a loading screen until a job finishes, along with the progress reported by the solver (elapsed time,
+ * iterations, nodes explored, best length and optimality gap), which can be cancelled by typing "cancel" (if the input
+ * comes from a terminal)
+ * @param job job whose completion is awaited
+ * @param progress Progress of the solver (may be nullptr, if the job does not report any)
+ */
+void Helpy::printLoadingScreen(std::future<void> &job, Progress *progress) {
+    bool interactive = progress && isatty(STDIN_FILENO);
     int dots = 0;
 
     cout << BREAK;
+    if (interactive)
+        cout << "Type " << BOLD << YELLOW << "cancel" << RESET << " at any time to stop the computation."
+             << endl << endl;
+
     cout << BLUE << "Loading" << std::flush;
 
-    while (loading) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    while (job.wait_for(std::chrono::milliseconds(500)) != std::future_status::ready) {
+        dots = (dots + 1) % 4;
+        cout << "\r\033[K" << BLUE << "Loading" << string(dots, '.') << string(3 - dots, ' ') << RESET;
 
-        if (dots < 3) {
-            cout << '.' << std::flush;
-            ++dots;
+        if (progress) {
+            Progress::Snapshot state = progress->snapshot();
+            std::ostringstream status;
 
-            continue;
+            status << std::fixed << std::setprecision(1) << "  Elapsed: " << YELLOW << state.elapsed << 's' << RESET
+                   << " | Iterations: " << YELLOW << state.iterations << RESET;
+
+            if (state.nodes) status << " | Nodes: " << YELLOW << state.nodes << RESET;
+            if (std::isfinite(state.best)) status << " | Best: " << YELLOW << state.best << " m" << RESET;
+            if (std::isfinite(state.gap())) status << " | Gap: " << YELLOW << 100 * state.gap() << '%' << RESET;
+
+            cout << status.str();
         }
 
-        cout << "\rLoading" << std::flush;
-        dots = 0;
+        cout << std::flush;
+
+        // check, without blocking, if the user typed anything
+        pollfd input = {STDIN_FILENO, POLLIN, 0};
+        if (!interactive || progress->isCancelled() || poll(&input, 1, 0) <= 0) continue;
+
+        string line;
+        getline(std::cin, line);
+
+        if (!line.empty() && tolower(line[0]) == 'c') {
+            progress->cancel();
+            cout << endl << RED << "Cancelling..." << RESET << endl;
+        }
     }
 
     cout << RESET << '\r' << endl;
 }
 
 /**
- * @brief runs one of the TSP algorithms
+ * @brief runs one of the TSP algorithms, as an asynchronous job (if multithreading is enabled), and reports how far
+ * the computed path is, at most, from the optimal one
  * @param n number that indicates which algorithm should be executed
  */
 void Helpy::runAlgorithm(int n) {
-    // create a new thread to show a loading screen
-    std::thread *t1 = nullptr;
+    Progress progress;
+    Tour res;
+    double bound = 0;
 
-    if (multithreading) {
-        loading = true;
-        t1 = new std::thread(&Helpy::printLoadingScreen, this);
-    }
+    Profiler::Report before = Profiler::snapshot();
 
-    std::list<std::pair<int, double>> res;
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now(), end = start;
 
-    switch (n) {
-        case (1) : {
-            res = graph.backtracking(src);
-            break;
-        }
-        case (2) : {
-            res = graph.triangularInequality(src);
-            break;
-        }
-        case (3) : {
-            res = graph.other(src);
-        }
-        default : break;
-    }
+    auto solve = [this, n, &progress, &res, &bound, &end]() {
+        // if the cache is enabled, repeated requests (even from another source) are answered with the tour cached by
+        // the first one
+        res = graph.solve(TSPGraph::algorithms()[n - 1], src, 0, progress, cache ? &SolutionCache::shared() : nullptr);
 
+        end = std::chrono::high_resolution_clock::now();
+
+        // if asked to, tighten the lower bound (outside the timed section), unless the solver has already proven the
+        // path optimal
+        bound = progress.snapshot().bound;
+
+        if (tightBound && res.hasDistances() && !progress.isCancelled() && bound < res.getLength())
+            bound = std::max(bound, graph.lowerBound(HeldKarp::Config(), res.getLength()));
+    };
+
+    // run the solver in the background, while the loading screen reports its progress
     if (multithreading) {
-        loading = false;
-        t1->join();
+        std::future<void> job = std::async(std::launch::async, solve);
 
-        delete t1;
+        printLoadingScreen(job, &progress);
+        job.get();
     }
+    else solve();
 
-    auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
     cout << BREAK;
-    cout << "These are the results of my computation: " << endl << endl;
+
+    if (progress.isCancelled())
+        cout << RED << "The computation was cancelled!" << RESET << " This is the best path found so far: "
+             << endl << endl;
+    else cout << "These are the results of my computation: " << endl << endl;
+
+    if (format != "table") {
+        Profiler::Report profile = loading + (Profiler::snapshot() - before);
+
+        if (!writeResult(res, n, duration, bound, progress.isCancelled(), profile))
+            cout << RED << "Could not write the results to " << outputPath << '!' << RESET << endl;
+        else if (!outputPath.empty())
+            cout << BOLD << GREEN << "Done!" << RESET << " The results were written to " << BOLD << YELLOW
+                 << outputPath << RESET << '.' << endl;
+
+        return;
+    }
+
     printPath(res);
 
     cout << BOLD << "Execution time: " << YELLOW << Utils::toTime(duration) << RESET
          << endl;
+
+    printProfile(loading + (Profiler::snapshot() - before));
+
+    if (bound <= 0 || !res.hasDistances()) return;
+
+    std::ostringstream gap;
+    gap << std::fixed << std::setprecision(2) << 100 * (res.getLength() - bound) / bound << '%';
+
+    cout << BOLD << "Optimality gap: " << YELLOW << gap.str() << RESET << " (lower bound: " << bound << " m)" << endl;
 }
 
 /**
@@ -447,22 +637,16 @@ void Helpy::changeCurrentGraph() {
     uSet<string> options = {"yes", "no"};
     bool hasHeader = (readInput(instr.str(), options) == "yes");
 
-    // create a new thread to show a loading screen
-    std::thread *t1 = nullptr;
-
-    if (multithreading) {
-        loading = true;
-        t1 = new std::thread(&Helpy::printLoadingScreen, this);
-    }
-
-    fetchData(path, hasHeader);
-
+    // load the graph in the background, while showing a loading screen
     if (multithreading) {
-        loading = false;
-        t1->join();
+        std::future<void> job = std::async(std::launch::async, [this, &path, hasHeader]() {
+            fetchData(path, hasHeader);
+        });
 
-        delete t1;
+        printLoadingScreen(job);
+        job.get();
     }
+    else fetchData(path, hasHeader);
 
     cout << BREAK;
     cout << BOLD << GREEN << "Done!" << RESET << " The new graph has successfully been loaded!" << endl << endl;
@@ -495,6 +679,56 @@ void Helpy::changeCurrentSource() {
          << BOLD << YELLOW << src - 1 << RESET << '.' << endl;
 }
 
+/**
+ * @brief allows the user to change the format in which the results of the TSP algorithms are shown and, for the
+ * machine-readable formats, the file where they are written
+ */
+void Helpy::changeCurrentFormat() {
+    std::ostringstream instr;
+    instr << "Which " << BOLD << "format" << RESET << " would you like the results to be shown in?" << endl << endl
+          << "* Table" << endl
+          << "* CSV" << endl
+          << "* JSON";
+
+    uSet<string> options = {"table", "csv", "json"};
+    format = readInput(instr.str(), options);
+    outputPath.clear();
+
+    if (format != "table") {
+        cout << BREAK;
+        cout << "Please type the " << BOLD << "relative path" << RESET << " to the file where the results should be "
+             << "written, or " << BOLD << YELLOW << "terminal" << RESET << " to show them here:" << endl << endl;
+
+        string path;
+        getline(std::cin >> std::ws, path);
+
+        string lowercase = path;
+        Utils::lowercase(lowercase);
+
+        if (lowercase != "terminal") outputPath = pathToRoot + path;
+    }
+
+    displayCurrentFormat();
+}
+
+/**
+ * @brief displays the format in which the results of the TSP algorithms are shown
+ */
+void Helpy::displayCurrentFormat() const {
+    cout << BREAK;
+
+    if (format == "table") {
+        cout << "The results are shown as a " << BOLD << YELLOW << "table" << RESET << '.' << endl;
+        return;
+    }
+
+    string name = format;
+    Utils::lowercase(name, true);
+
+    cout << "The results are written as " << BOLD << YELLOW << name << RESET << " to "
+         << BOLD << YELLOW << (outputPath.empty() ? "the terminal" : outputPath) << RESET << '.' << endl;
+}
+
 /**
  * @brief displays the index of the starting vertex of the TSP
  */
@@ -514,3 +748,27 @@ void Helpy::toggleMultithreading() {
     cout << BOLD << GREEN << "Done! " << RESET << "Multithreading is now " << BOLD << YELLOW
          << (multithreading ? "enabled" : "disabled") << RESET << '.' << endl;
 }
+
+/**
+ * @brief allows the user to toggle the cache of the tours on/off, so that repeated runs of the same algorithm on the
+ * same graph (even from another source) reuse the tour of the first one
+ */
+void Helpy::toggleCache() {
+    cache ^= 1;
+
+    cout << BREAK;
+    cout << BOLD << GREEN << "Done! " << RESET << "The cache of the tours is now " << BOLD << YELLOW
+         << (cache ? "enabled" : "disabled") << RESET << '.' << endl;
+}
+
+/**
+ * @brief allows the user to toggle the Held-Karp lower bound of the results on/off, which tells how far each path is,
+ * at most, from the optimal one, but takes a while to compute (and is never computed for large graphs)
+ */
+void Helpy::toggleBound() {
+    tightBound ^= 1;
+
+    cout << BREAK;
+    cout << BOLD << GREEN << "Done! " << RESET << "The lower bound of the results is now " << BOLD << YELLOW
+         << (tightBound ? "computed" : "skipped") << RESET << '.' << endl;
+}
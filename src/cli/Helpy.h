@@ -1,7 +1,12 @@
 #ifndef DA_TRAINS_HELPY_H
 #define DA_TRAINS_HELPY_H
 
+#include <future>
+
+#include "../utils/Profiler.h"
+#include "../utils/Progress.h"
 #include "../utils/Reader.h"
+#include "../utils/ResultWriter.h"
 #include "../utils/Utils.hpp"
 #include "../network/TSPGraph.h"
 
@@ -12,9 +17,12 @@ class Helpy {
 private:
     TSPGraph graph;
     Reader reader;
-    string pathToRoot;
+    string pathToRoot, graphPath;
     int src;
-    bool multithreading, loading;
+    bool multithreading, cache; // cache indicates if the tours are reused by repeated runs (see SolutionCache)
+    bool tightBound;            // indicates if the Held-Karp bound of every result is computed (which is slow)
+    string format, outputPath;  // format of the results ("table", "csv" or "json") and file where they are written
+    Profiler::Report loading;   // what was recorded while the current graph was loaded
 
     // maps used to process commands
     static std::map<string, int> command, target, what;
@@ -34,15 +42,22 @@ private:
     void guidedMode();
     bool processCommand(string& s1, string& s2, string& s3);
 
-    static void printPath(std::list<std::pair<int, double>> &path);
-    void printLoadingScreen() const;
+    static void printPath(const Tour &path);
+    bool writeResult(const Tour &path, int n, long long duration, double bound, bool cancelled,
+                     const Profiler::Report &profile) const;
+    static void printProfile(const Profiler::Report &profile);
+    static void printLoadingScreen(std::future<void> &job, Progress *progress = nullptr);
     void runAlgorithm(int n);
 
     // commands
     void changeCurrentGraph();
     void changeCurrentSource();
     void displayCurrentSource() const;
+    void changeCurrentFormat();
+    void displayCurrentFormat() const;
     void toggleMultithreading();
+    void toggleCache();
+    void toggleBound();
 
 public:
     void terminal();
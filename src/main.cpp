@@ -1,6 +1,29 @@
+#include <string>
+
+#include "cli/Batch.h"
+#include "cli/Bench.h"
 #include "cli/Helpy.h"
+#include "server/Server.h"
+
+int main(int argc, char *argv[]) {
+    // '--serve' starts the daemon mode, which keeps the graphs in memory between requests
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        Server server;
+        return server.parse(argc, argv) ? server.run() : 1;
+    }
+
+    // '--bench' measures the algorithms on the bundled datasets
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        Bench bench;
+        return bench.parse(argc, argv) ? bench.run() : 1;
+    }
+
+    // any other argument starts the batch mode, which runs without user interaction
+    if (argc > 1) {
+        Batch batch;
+        return batch.parse(argc, argv) ? batch.run() : 1;
+    }
 
-int main() {
     Helpy CLI = Helpy();
     CLI.terminal();
 
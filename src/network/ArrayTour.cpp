@@ -0,0 +1,149 @@
+#include <algorithm>
+
+#include "ArrayTour.h"
+
+/**
+ * @brief creates a new ArrayTour
+ * @complexity O(|V|)
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ */
+ArrayTour::ArrayTour(const std::vector<int> &order) : order(order), journaling(false) {
+    position.resize(*std::max_element(order.begin(), order.end()) + 1, -1);
+
+    for (int i = 0; i < (int) order.size(); ++i)
+        position[order[i]] = i;
+}
+
+/**
+ * @brief returns the number of vertices of the tour
+ * @return number of vertices of the tour
+ */
+int ArrayTour::size() const {
+    return (int) order.size();
+}
+
+/**
+ * @brief checks if a vertex lies on the path that goes from one vertex to another
+ * @complexity O(1)
+ * @param a index of the first vertex of the path
+ * @param b index of the vertex to be checked
+ * @param c index of the last vertex of the path
+ * @return 'true' if b is visited when going from a to c, 'false' otherwise
+ */
+bool ArrayTour::between(int a, int b, int c) const {
+    int i = position[a], j = position[b], k = position[c];
+    return (i <= k) ? (i <= j && j <= k) : (j >= i || j <= k);
+}
+
+/**
+ * @brief reverses the path that goes from one vertex to another
+ * @note the complementary path is reversed instead if it is shorter, which yields the same cycle
+ * @complexity O(|V|)
+ * @param from index of the first vertex of the path
+ * @param to index of the last vertex of the path
+ */
+void ArrayTour::reverse(int from, int to) {
+    int n = size();
+    int i = position[from], j = position[to];
+
+    int length = j - i;
+    if (length < 0) length += n;
+    ++length;
+
+    // reverse the shorter side
+    if (2 * length > n) {
+        std::swap(i, j);
+        i = (i + 1) % n;
+        j = (j - 1 + n) % n;
+
+        length = n - length;
+    }
+
+    if (journaling) journal.push_back({i, j, length, true});
+    reversePositions(i, j, length);
+}
+
+/**
+ * @brief reverses the vertices of a range of positions (which is its own inverse)
+ * @complexity O(length)
+ * @param i first position of the range
+ * @param j last position of the range (which may wrap around the end of the tour)
+ * @param length number of positions in the range
+ */
+void ArrayTour::reversePositions(int i, int j, int length) {
+    int n = size();
+
+    for (int k = 0; k < length / 2; ++k) {
+        std::swap(order[i], order[j]);
+        position[order[i]] = i;
+        position[order[j]] = j;
+
+        if (++i == n) i = 0;
+        if (--j < 0) j = n - 1;
+    }
+}
+
+/**
+ * @brief exchanges two adjacent sections of the tour, i.e. the positions [i, j[ and [j, k[
+ * @complexity O(k - i)
+ * @param i first position of the first section
+ * @param j first position of the second section
+ * @param k position after the end of the second section
+ */
+void ArrayTour::exchange(int i, int j, int k) {
+    if (journaling) journal.push_back({i, j, k, false});
+    exchangePositions(i, j, k);
+}
+
+/**
+ * @brief exchanges two adjacent sections of the tour, without recording it
+ * @complexity O(k - i)
+ * @param i first position of the first section
+ * @param j first position of the second section
+ * @param k position after the end of the second section
+ */
+void ArrayTour::exchangePositions(int i, int j, int k) {
+    std::rotate(order.begin() + i, order.begin() + j, order.begin() + k);
+
+    for (int p = i; p < k; ++p)
+        position[order[p]] = p;
+}
+
+/**
+ * @brief marks the current tour, recording every later change, so that rollback() can return to it (which is much
+ * cheaper than a copy of the tour when only a few positions change)
+ */
+void ArrayTour::mark() {
+    journaling = true;
+    journal.clear();
+}
+
+/**
+ * @brief undoes every change made since the last mark, in reverse order, returning to the exact same tour
+ * @complexity O(total length of the changes)
+ */
+void ArrayTour::rollback() {
+    for (auto it = journal.rbegin(); it != journal.rend(); ++it) {
+        if (it->reversal) reversePositions(it->i, it->j, it->k);
+        else exchangePositions(it->i, it->i + it->k - it->j, it->k);
+    }
+
+    journal.clear();
+}
+
+/**
+ * @brief returns the vertices of the tour, in the order they are visited
+ * @complexity O(|V|)
+ * @param start index of the vertex the tour should start at
+ * @return std::vector containing the indices of the vertices in the order they are visited
+ */
+std::vector<int> ArrayTour::toVector(int start) const {
+    std::vector<int> res;
+    res.reserve(order.size());
+
+    int i = position[start];
+    res.insert(res.end(), order.begin() + i, order.end());
+    res.insert(res.end(), order.begin(), order.begin() + i);
+
+    return res;
+}
@@ -0,0 +1,69 @@
+#ifndef DA_PROJ2_ARRAYTOUR_H
+#define DA_PROJ2_ARRAYTOUR_H
+
+#include <vector>
+
+class ArrayTour {
+/* ATTRIBUTES */
+private:
+    struct Change {
+        int i, j, k;           // positions given to the reversal (i, j and its length) or to the exchange
+        bool reversal;
+    };
+
+    std::vector<int> order;    // vertex at each position of the tour
+    std::vector<int> position; // position of each vertex in the tour
+
+    bool journaling;
+    std::vector<Change> journal; // changes since the last mark, in the order they were made
+
+/* CONSTRUCTOR */
+public:
+    explicit ArrayTour(const std::vector<int> &order);
+
+/* METHODS */
+private:
+    void reversePositions(int i, int j, int length);
+    void exchangePositions(int i, int j, int k);
+
+public:
+    int size() const;
+
+    /**
+     * @brief returns the vertex at a given position of the tour
+     * @param i position in the tour
+     * @return index of the vertex
+     */
+    int at(int i) const {
+        return order[i];
+    }
+
+    /**
+     * @brief returns the vertex that is visited after a given vertex
+     * @param v index of the vertex
+     * @return index of the next vertex
+     */
+    int next(int v) const {
+        int i = position[v] + 1;
+        return order[i == (int) order.size() ? 0 : i];
+    }
+
+    /**
+     * @brief returns the vertex that is visited before a given vertex
+     * @param v index of the vertex
+     * @return index of the previous vertex
+     */
+    int prev(int v) const {
+        int i = position[v];
+        return order[i ? i - 1 : order.size() - 1];
+    }
+
+    bool between(int a, int b, int c) const;
+    void reverse(int from, int to);
+    void exchange(int i, int j, int k);
+    void mark();
+    void rollback();
+    std::vector<int> toVector(int start) const;
+};
+
+#endif //DA_PROJ2_ARRAYTOUR_H
@@ -0,0 +1,242 @@
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DistanceMatrix.h"
+
+// identifies the files where the matrices are persisted (the last character is the version of the format)
+#define CACHE_MAGIC "DAP2MTX2"
+
+// size (in bytes) above which a matrix is not persisted (about 11500 vertices), so that the cache cannot fill the disk
+#define CACHE_LIMIT (1ULL << 30)
+
+/*
+ * layout of a persisted matrix: this header, followed by the whole matrix, row by row, as native doubles, so that the
+ * file can be mapped into memory and read in place, without any parsing or copying
+ */
+struct CacheHeader {
+    char magic[8];
+    uint64_t key;
+    uint64_t size;
+};
+
+/**
+ * @brief creates a new, empty DistanceMatrix
+ */
+DistanceMatrix::DistanceMatrix()
+    : size(0), built(new std::once_flag()), cacheKey(0), cached(false), filled(false), saved(new std::once_flag()),
+      mapping(nullptr), mappingSize(0), mapped(nullptr) {}
+
+/**
+ * @brief creates a new, empty DistanceMatrix
+ * @note the cache is not copied (a once_flag cannot be), so the copy will be rebuilt on its first use (although the
+ * file where it is persisted is kept)
+ * @param m DistanceMatrix to be copied
+ */
+DistanceMatrix::DistanceMatrix(const DistanceMatrix &m) : DistanceMatrix() {
+    cachePath = m.cachePath;
+    cacheKey = m.cacheKey;
+}
+
+/**
+ * @brief releases the file the matrix was read from
+ */
+DistanceMatrix::~DistanceMatrix() {
+    unmap();
+}
+
+/**
+ * @brief allocates the memory of the cache
+ * @param n number of rows (and columns) of the matrix
+ */
+void DistanceMatrix::allocate(int n) {
+    size = n;
+    values.reset(new std::atomic<double>[(size_t) size * size]);
+    rows.reset(new std::once_flag[size]);
+}
+
+/**
+ * @brief copies the values of a matrix into the cache
+ * @param m matrix whose values will be copied
+ */
+void DistanceMatrix::assign(const std::vector<std::vector<double>> &m) {
+    allocate((int) m.size());
+
+    for (int i = 0; i < size; ++i)
+        for (int j = 0; j < size; ++j)
+            values[(size_t) i * size + j].store(m[i][j], std::memory_order_relaxed);
+}
+
+/**
+ * @brief unmaps the file the matrix was read from, if it was
+ */
+void DistanceMatrix::unmap() {
+    if (mapping) munmap(mapping, mappingSize);
+
+    mapping = nullptr;
+    mappingSize = 0;
+    mapped = nullptr;
+}
+
+/**
+ * @brief resets the DistanceMatrix, so that it is rebuilt on its next use
+ * @param m DistanceMatrix to be copied
+ * @return reference to the DistanceMatrix
+ */
+DistanceMatrix &DistanceMatrix::operator=(const DistanceMatrix &m) {
+    if (this == &m) return *this;
+
+    size = 0;
+    values.reset();
+    rows.reset();
+    built.reset(new std::once_flag());
+
+    cachePath = m.cachePath;
+    cacheKey = m.cacheKey;
+    cached = false;
+    filled = false;
+    saved.reset(new std::once_flag());
+    unmap();
+
+    return *this;
+}
+
+/**
+ * @brief reads the matrix from the file where it is persisted, by mapping it into memory, where it stays (the
+ * distances are then read straight from the file, which is only paged in as they are used)
+ * @complexity O(1)
+ * @return 'true' if the file exists and matches the key of the matrix, 'false' otherwise
+ */
+bool DistanceMatrix::readCache() {
+    if (cachePath.empty()) return false;
+
+    int fd = open(cachePath.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat info = {};
+    void *data = MAP_FAILED;
+
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t) sizeof(CacheHeader))
+        data = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    auto header = (const CacheHeader *) data;
+    uint64_t n = header->size;
+
+    cached = !memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) && header->key == cacheKey && n < INT_MAX
+             && (uint64_t) info.st_size == sizeof(CacheHeader) + n * n * sizeof(double);
+
+    if (!cached) {
+        munmap(data, (size_t) info.st_size);
+        return false;
+    }
+
+    size = (int) n;
+    rows.reset(new std::once_flag[size]);
+
+    mapping = data;
+    mappingSize = (size_t) info.st_size;
+    mapped = (const double *) (header + 1);
+
+    filled = true;
+    return true;
+}
+
+/**
+ * @brief writes the matrix to the file where it is persisted (through a temporary file, so that a reader never sees
+ * a file that is only partially written)
+ * @complexity O(|V|^2)
+ * @return 'true' if the file was written, 'false' otherwise
+ */
+bool DistanceMatrix::writeCache() const {
+    if ((uint64_t) size * size * sizeof(double) > CACHE_LIMIT) return false;
+
+    std::string temporary = cachePath + '.' + std::to_string(getpid());
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+
+    CacheHeader header = {};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.key = cacheKey;
+    header.size = (uint64_t) size;
+
+    out.write((const char *) &header, sizeof(header));
+
+    std::vector<double> row((size_t) size);
+
+    for (int i = 0; i < size && out; ++i) {
+        for (int j = 0; j < size; ++j)
+            row[j] = at(i, j);
+
+        out.write((const char *) row.data(), (std::streamsize) (size * sizeof(double)));
+    }
+
+    out.close();
+
+    if (!out || rename(temporary.c_str(), cachePath.c_str()) != 0) {
+        remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief returns the number of rows (and columns) of the matrix
+ * @return number of rows of the matrix
+ */
+int DistanceMatrix::dimension() const {
+    return size;
+}
+
+/**
+ * @brief indicates if the matrix has not been built yet
+ * @return 'true' if the matrix has not been built, 'false' otherwise
+ */
+bool DistanceMatrix::empty() const {
+    return !size;
+}
+
+/**
+ * @brief stores the distance between two vertices
+ * @note safe to call concurrently, as every thread computes the same value for the same pair of vertices (and never
+ * called on a matrix that was read from its file, as it already has every distance)
+ * @param src index of the source vertex
+ * @param dest index of the destination vertex
+ * @param distance distance between the vertices
+ */
+void DistanceMatrix::set(int src, int dest, double distance) {
+    values[(size_t) src * size + dest].store(distance, std::memory_order_relaxed);
+    values[(size_t) dest * size + src].store(distance, std::memory_order_relaxed);
+}
+
+/**
+ * @brief sets the file where the matrix is persisted, which is reused by later runs as long as its key matches
+ * @note must be called before the matrix is built
+ * @param path path to the file
+ * @param key value that identifies the data the matrix is computed from (e.g. a hash of the files of the graph)
+ */
+void DistanceMatrix::setCache(const std::string &path, uint64_t key) {
+    cachePath = path;
+    cacheKey = key;
+}
+
+/**
+ * @brief writes the matrix to the file where it is persisted, exactly once, unless it was read from that file, it is
+ * larger than CACHE_LIMIT or some of its distances are still unknown (in which case nothing is written yet)
+ * @note meant to be called once a run is over, as writing the file is not part of the work of any algorithm
+ */
+void DistanceMatrix::persist() {
+    if (!filled || cachePath.empty() || cached) return;
+
+    std::call_once(*saved, [this]() {
+        TRACE_SCOPE("persist matrix");
+        writeCache();
+    });
+}
@@ -0,0 +1,135 @@
+#ifndef DA_PROJ2_DISTANCEMATRIX_H
+#define DA_PROJ2_DISTANCEMATRIX_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../utils/Profiler.h"
+#include "../utils/Tracer.h"
+
+class DistanceMatrix {
+/* ATTRIBUTES */
+private:
+    int size;
+    std::unique_ptr<std::atomic<double>[]> values;
+    std::unique_ptr<std::once_flag[]> rows;
+    std::unique_ptr<std::once_flag> built;
+
+    // file where the matrix is persisted, which is only reused if its key matches (empty if it is not persisted)
+    std::string cachePath;
+    uint64_t cacheKey;
+    bool cached;                // indicates if the matrix was read from the file
+    std::atomic<bool> filled;   // indicates if every distance is known, so that the matrix can be persisted
+    std::unique_ptr<std::once_flag> saved;
+
+    // file the matrix was read from, which stays mapped and is read in place of the values (nullptr if it was not)
+    void *mapping;
+    size_t mappingSize;
+    const double *mapped;
+
+/* CONSTRUCTORS */
+public:
+    DistanceMatrix();
+    DistanceMatrix(const DistanceMatrix &m);
+    ~DistanceMatrix();
+
+/* METHODS */
+private:
+    void allocate(int n);
+    void assign(const std::vector<std::vector<double>> &m);
+    void unmap();
+    bool readCache();
+    bool writeCache() const;
+
+public:
+    DistanceMatrix &operator=(const DistanceMatrix &m);
+
+    /**
+     * @brief builds the matrix from the result of a function (or from its file, if it is persisted and up to date),
+     * exactly once, even if called by several threads
+     * @param init function that returns the initial matrix (negative entries represent unknown distances)
+     */
+    template <typename F>
+    void build(F init) {
+        std::call_once(*built, [this, &init]() {
+            PROFILE_SCOPE(MATRIX);
+            if (!readCache()) assign(init());
+        });
+    }
+
+    /**
+     * @brief computes every unknown distance of a row, exactly once, even if called by several threads
+     * @param row index of the row
+     * @param compute function that computes the distance between two vertices
+     */
+    template <typename F>
+    void fillRow(int row, F compute) {
+        std::call_once(rows[row], [this, row, &compute]() {
+            PROFILE_SCOPE(MATRIX);
+            TRACE_SCOPE("matrix row", row);
+
+            for (int col = 1; col < size; ++col) {
+                if (at(row, col) < 0)
+                    set(row, col, compute(row, col));
+            }
+        });
+    }
+
+    /**
+     * @brief computes every unknown distance of the matrix, after which it can be persisted
+     * @note safe to call concurrently, as each row is only filled once
+     * @param compute function that computes the distance between two vertices
+     */
+    template <typename F>
+    void fill(F compute) {
+        for (int row = 1; row < size; ++row)
+            fillRow(row, compute);
+
+        filled = true;
+    }
+
+    int dimension() const;
+    bool empty() const;
+
+    /**
+     * @brief indicates if a distance stands for a missing edge (INF, in a graph that is not complete), which must never
+     * take part in an incremental update of a length, as it absorbs (or overflows) whatever is added to it
+     * @param distance distance between two vertices
+     * @return 'true' if the distance is INF, 'false' otherwise
+     */
+    static bool isMissing(double distance) {
+        return distance >= std::numeric_limits<double>::max();
+    }
+
+    /**
+     * @brief returns the distance between two vertices
+     * @param src index of the source vertex
+     * @param dest index of the destination vertex
+     * @return distance between the vertices (negative if it has not been computed yet)
+     */
+    double at(int src, int dest) const {
+        size_t i = (size_t) src * size + dest;
+        return mapped ? mapped[i] : values[i].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief returns the distance between two vertices
+     * @param src index of the source vertex
+     * @param dest index of the destination vertex
+     * @return distance between the vertices (negative if it has not been computed yet)
+     */
+    double operator()(int src, int dest) const {
+        return at(src, dest);
+    }
+
+    void set(int src, int dest, double distance);
+    void setCache(const std::string &path, uint64_t key);
+    void persist();
+};
+
+#endif //DA_PROJ2_DISTANCEMATRIX_H
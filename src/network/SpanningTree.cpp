@@ -0,0 +1,59 @@
+#include "SpanningTree.h"
+
+/**
+ * @brief creates a compact (CSR) representation of a rooted spanning tree
+ * @complexity O(|V|)
+ * @param n number of vertices of the graph
+ * @param root index of the root of the tree
+ * @param edges edges of the tree, each directed from the parent to the child
+ */
+SpanningTree::SpanningTree(int n, int root, const std::list<Edge *> &edges)
+    : root(root), offsets(n + 2, 0), children(edges.size()) {
+    // count the children of each vertex
+    for (const Edge *e : edges)
+        ++offsets[e->getSrc() + 1];
+
+    for (int v = 1; v <= n + 1; ++v)
+        offsets[v] += offsets[v - 1];
+
+    // place each child in the slot of its parent
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+
+    for (const Edge *e : edges)
+        children[next[e->getSrc()]++] = e->getDest();
+}
+
+/**
+ * @brief returns the number of children of a vertex
+ * @param v index of the vertex
+ * @return number of children of the vertex
+ */
+int SpanningTree::countChildren(int v) const {
+    return offsets[v + 1] - offsets[v];
+}
+
+/**
+ * @brief computes the preorder traversal of the tree, using an iterative DFS over a preallocated stack
+ * @complexity O(|V|)
+ * @return std::vector containing the indices of the vertices in the order they were visited
+ */
+std::vector<int> SpanningTree::preorder() const {
+    std::vector<int> order;
+    order.reserve(children.size() + 1);
+
+    std::vector<int> stack(children.size() + 1);
+    int top = 0;
+
+    stack[top++] = root;
+
+    while (top) {
+        int curr = stack[--top];
+        order.push_back(curr);
+
+        // push the children in reverse, so that they are visited in their original order
+        for (int i = offsets[curr + 1] - 1; i >= offsets[curr]; --i)
+            stack[top++] = children[i];
+    }
+
+    return order;
+}
@@ -0,0 +1,26 @@
+#ifndef DA_PROJ2_SPANNINGTREE_H
+#define DA_PROJ2_SPANNINGTREE_H
+
+#include <list>
+#include <vector>
+
+#include "UGraph.h"
+
+class SpanningTree {
+/* ATTRIBUTES */
+private:
+    int root;
+    std::vector<int> offsets;  // children of vertex v are children[offsets[v] .. offsets[v + 1] - 1]
+    std::vector<int> children;
+
+/* CONSTRUCTOR */
+public:
+    SpanningTree(int n, int root, const std::list<Edge *> &edges);
+
+/* METHODS */
+public:
+    int countChildren(int v) const;
+    std::vector<int> preorder() const;
+};
+
+#endif //DA_PROJ2_SPANNINGTREE_H
@@ -1,27 +1,38 @@
 #include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <stack>
+#include <mutex>
 
+#include "ArrayTour.h"
+#include "SpanningTree.h"
 #include "TSPGraph.h"
+#include "TwoLevelTour.h"
+#include "../parallel/ThreadPool.h"
+#include "../solvers/Candidates.h"
+#include "../utils/Profiler.h"
+#include "../utils/Tracer.h"
+#include "../utils/Utils.hpp"
+
+// number of vertices above which a graph is large, i.e. its local search uses a TwoLevelTour instead of an ArrayTour
+// and its distances are looked up on demand, instead of being kept in a dense (O(|V|^2)) matrix
+#define LARGE_THRESHOLD 50000
+
+// size of the candidate list of each vertex, in the 2-opt local search
+#define TWO_OPT_CANDIDATES 10
 
 /**
  * @brief creates a new TSPGraph
  * @param isReal indicates if the graph represents real world locations
 */
-TSPGraph::TSPGraph(bool isReal) : UGraph(0), isReal(isReal) {}
+TSPGraph::TSPGraph(bool isReal) : UGraph(0), isReal(isReal), hash(0) {}
 
 /**
- * @brief calculates the great-circle distance between two vertices, using the Haversine formula
- * @param src index of the source vertex
- * @param dest index of the destination vertex
- * @return distance between the two vertices (in meters)
+ * @brief calculates the great-circle distance between two places, using the Haversine formula
+ * @param lhs first place
+ * @param rhs second place
+ * @return distance between the two places (in meters)
  */
-double TSPGraph::haversine(int src, int dest) {
-    if (!isReal) return INF;
-
-    auto &lhs = (Place &) (*this)[src];
-    auto &rhs = (Place &) (*this)[dest];
-
+double TSPGraph::haversine(const Place &lhs, const Place &rhs) {
     double srcLat = lhs.getLatitude();
     double destLat = rhs.getLatitude();
 
@@ -42,6 +53,242 @@ double TSPGraph::haversine(int src, int dest) {
     return 6371000 * sine; // 6371000 -> Earth's radius (in meters)
 }
 
+/**
+ * @brief calculates the great-circle distance between two vertices, using the Haversine formula
+ * @param src index of the source vertex
+ * @param dest index of the destination vertex
+ * @return distance between the two vertices (in meters)
+ */
+double TSPGraph::haversine(int src, int dest) {
+    if (!isReal) return INF;
+    return haversine((Place &) (*this)[src], (Place &) (*this)[dest]);
+}
+
+/**
+ * @brief computes the distance between two vertices, without looking it up in the distance matrix
+ * @param src index of the source vertex
+ * @param dest index of the destination vertex
+ * @return distance between the two vertices
+ */
+double TSPGraph::computeDistance(int src, int dest) {
+    return isReal ? haversine(src, dest) : distance(src, dest);
+}
+
+/**
+ * @brief indicates if the graph is too large for a dense distance matrix
+ * @return 'true' if the graph has more than LARGE_THRESHOLD vertices, 'false' otherwise
+ */
+bool TSPGraph::isLarge() {
+    return countVertices() > LARGE_THRESHOLD;
+}
+
+/**
+ * @brief builds the distance matrix from the edges of the graph, if it has not been built yet (and the graph is not
+ * large, as its distances are then looked up on demand)
+ * @note safe to call concurrently, as the matrix is only built once
+ */
+void TSPGraph::buildMatrix() {
+    if (!isLarge()) matrix.build([this]() { return toMatrix(); });
+}
+
+/**
+ * @brief returns the distance between two vertices, computing (and caching) it if it is not known yet or, in a large
+ * graph, looking it up among the edges of the source (and computing it from the coordinates if there is no such edge)
+ * @note safe to call concurrently, as lazily computed distances are stored atomically
+ * @complexity O(1), or O(degree of the source) in a large graph
+ * @param src index of the source vertex
+ * @param dest index of the destination vertex
+ * @return distance between the two vertices
+ */
+double TSPGraph::dist(int src, int dest) {
+    if (isLarge()) {
+        if (src == dest) return 0;
+
+        double d = distance(src, dest);
+        return (d >= INF && isReal) ? haversine(src, dest) : d;
+    }
+
+    double d = matrix(src, dest);
+    if (d >= 0) return d;
+
+    d = computeDistance(src, dest);
+    matrix.set(src, dest, d);
+
+    return d;
+}
+
+/**
+ * @brief computes the candidate list of each vertex, i.e. its k nearest neighbours among the destinations of its edges
+ * and (if the graph represents real world locations) among the places closest to it, sorted by distance, without
+ * scanning every pair of vertices
+ * @complexity O(|E| * log(k) + |V| * k * log(k))
+ * @param k number of candidates of each vertex
+ * @return std::vector containing the candidates of each vertex
+ */
+std::vector<std::vector<int>> TSPGraph::candidates(int k) {
+    int n = countVertices();
+    std::vector<std::vector<int>> res(n + 1);
+
+    if (isReal) {
+        // project the places onto a plane, where the nearest ones are (roughly) the same as on the sphere
+        std::vector<double> x(n + 1), y(n + 1);
+
+        for (int v = 1; v <= n; ++v) {
+            const Place &place = (const Place &) (*this)[v];
+
+            y[v] = place.getLatitude();
+            x[v] = place.getLongitude() * cos(place.getLatitude() * M_PI / 180);
+        }
+
+        res = Candidates::nearest(x, y, k);
+    }
+
+    for (int v = 1; v <= n; ++v) {
+        std::vector<int> &near = res[v];
+
+        for (const Edge *e : (*this)[v].outEdges())
+            if (e->getDest() != v) near.push_back(e->getDest());
+
+        std::sort(near.begin(), near.end());
+        near.erase(std::unique(near.begin(), near.end()), near.end());
+
+        std::vector<std::pair<double, int>> nearest;
+        for (int u : near) nearest.emplace_back(dist(v, u), u);
+
+        auto end = nearest.begin() + std::min((size_t) k, nearest.size());
+        std::partial_sort(nearest.begin(), end, nearest.end());
+
+        near.clear();
+        for (auto it = nearest.begin(); it != end && !DistanceMatrix::isMissing(it->first); ++it)
+            near.push_back(it->second);
+    }
+
+    return res;
+}
+
+/**
+ * @brief persists the distance matrix to a file, so that later runs on the same graph read it instead of computing it
+ * @note must be called before the matrix is used
+ * @param path path to the file
+ * @param key value that identifies the contents of the graph (the file is ignored if it was written for another key)
+ */
+void TSPGraph::setMatrixCache(const std::string &path, uint64_t key) {
+    matrix.setCache(path, key);
+}
+
+/**
+ * @brief writes the distance matrix to its cache file, if it has one and every distance has been computed (i.e. an
+ * algorithm that needed the whole matrix has run)
+ * @note meant to be called once the run is over, so that writing the file is not counted as part of it
+ */
+void TSPGraph::persistMatrix() {
+    matrix.persist();
+}
+
+/**
+ * @brief returns the distance matrix, after computing every distance that was not known yet
+ * @note safe to call concurrently, as each row of the matrix is only filled once
+ * @return fully populated distance matrix
+ */
+const DistanceMatrix &TSPGraph::getMatrix() {
+    // unlike the heuristics, the solvers that need the whole matrix get it even if the graph is large
+    matrix.build([this]() { return toMatrix(); });
+    matrix.fill([this](int src, int dest) { return computeDistance(src, dest); });
+
+    return matrix;
+}
+
+/**
+ * @brief computes a fingerprint of the graph, i.e. a 64-bit FNV-1a hash of its distance matrix, so that two graphs
+ * with the same distances (e.g. the same file, loaded twice) have the same fingerprint
+ * @note the fingerprint is only computed once, so the graph must not change afterwards (and it needs the whole
+ * matrix, so it is never computed for large graphs, see solve())
+ * @complexity O(|V|^2)
+ * @return fingerprint of the graph (never 0)
+ */
+uint64_t TSPGraph::fingerprint() {
+    if (hash) return hash;
+
+    const DistanceMatrix &distances = getMatrix();
+    int n = countVertices();
+
+    uint64_t h = Utils::hash(&n, sizeof(n));
+
+    // the matrix is symmetric, so its upper triangle identifies it
+    for (int i = 1; i <= n; ++i)
+        for (int j = i + 1; j <= n; ++j) {
+            double d = distances(i, j);
+            h = Utils::hash(&d, sizeof(d), h);
+        }
+
+    hash = h ? h : 1;
+    return hash;
+}
+
+/**
+ * @brief computes the Held-Karp lower bound on the length of the optimal tour, i.e. the weight of the minimum 1-tree
+ * after the penalties of the vertices have been optimized
+ * @complexity O(I * |V|^2), where I is the number of subgradient iterations
+ * @param config number of subgradient iterations and time budget
+ * @param upperBound length of a known tour, used to choose the step size (0 estimates it)
+ * @return lower bound on the length of the optimal tour (0 if the graph has less than 3 vertices, or if it is large,
+ * as the 1-trees need the whole distance matrix)
+ */
+double TSPGraph::lowerBound(const HeldKarp::Config &config, double upperBound) {
+    if (isLarge()) return 0;
+    return HeldKarp(getMatrix(), config).optimize(upperBound);
+}
+
+/**
+ * @brief reports a quick lower bound (the weight of a single minimum 1-tree) to a solver that is about to start
+ * @complexity O(|V|^2)
+ * @param progress Progress of the solver (may be nullptr)
+ */
+void TSPGraph::reportBound(Progress *progress) {
+    if (!progress) return;
+
+    HeldKarp::Config config;
+    config.iterations = 0;
+
+    progress->setBound(lowerBound(config));
+}
+
+/**
+ * @brief creates a Tour from the order in which the vertices are visited, computing the distance of each leg
+ * @complexity O(|V|)
+ * @param src index of the source vertex
+ * @param path std::vector containing the indices of the vertices (apart from the source) in the order they are visited
+ * @return Tour representing the path
+ */
+Tour TSPGraph::toTour(int src, const std::vector<int> &path) {
+    Tour tour(src, (int) path.size() + 1);
+
+    int prev = src;
+    for (int v : path) {
+        tour.add(v, dist(prev, v));
+        prev = v;
+    }
+
+    tour.close(dist(prev, src));
+    return tour;
+}
+
+/**
+ * @brief creates a Tour from a cycle that may start at any vertex, rotating it so that it starts at the source
+ * @complexity O(|V|)
+ * @param src index of the source vertex
+ * @param cycle std::vector containing the indices of all the vertices in the order they are visited
+ * @return Tour representing the cycle
+ */
+Tour TSPGraph::cycleToTour(int src, const std::vector<int> &cycle) {
+    auto it = std::find(cycle.begin(), cycle.end(), src);
+
+    std::vector<int> path(it + 1, cycle.end());
+    path.insert(path.end(), cycle.begin(), it);
+
+    return toTour(src, path);
+}
+
 /**
  * @brief computes an approximate solution to the TSP, using an implementation of the Nearest-Neighbours algorithm
  * @complexity O(|V| + |E|)
@@ -50,13 +297,14 @@ double TSPGraph::haversine(int src, int dest) {
  * @return std::vector containing the indices of the vertices in the order they were visited
  */
 std::vector<int> TSPGraph::nearestNeighbours(int src, double &distance) {
+    PROFILE_SCOPE(NEAREST_NEIGHBOURS);
     std::vector<int> path;
 
     int curr = src;
     distance = 0;
 
     while (path.size() < countVertices() - 1) {
-        int nearest;
+        int nearest = -1;
         double minDistance = INF;
 
         (*this)[curr].valid = false;
@@ -71,6 +319,16 @@ std::vector<int> TSPGraph::nearestNeighbours(int src, double &distance) {
             nearest = next;
         }
 
+        // a dead end (the graph is not complete), so continue from the closest vertex that has not been visited yet
+        if (nearest == -1) {
+            for (int v = 1; v <= countVertices(); ++v) {
+                if (!(*this)[v].valid || (nearest != -1 && dist(curr, v) >= minDistance)) continue;
+
+                minDistance = dist(curr, v);
+                nearest = v;
+            }
+        }
+
         path.emplace_back(nearest);
 
         curr = nearest;
@@ -81,181 +339,377 @@ std::vector<int> TSPGraph::nearestNeighbours(int src, double &distance) {
 }
 
 /**
- * @brief optimizes a path, using an implementation of the 2-optimization algorithm
- * @complexity O(|V|^2)
- * @param path std::vector containing the path (represented by the indices of the vertices) to be optimized
- * @param distance double where the distance of the initial path is stored and where the distance of the optimized
- * path will be stored
+ * @brief optimizes a tour, using an implementation of the 2-optimization algorithm, which tries every move on graphs
+ * of up to LARGE_THRESHOLD vertices and, on larger ones, is restricted to candidate lists, i.e. only the moves that add
+ * an edge between a vertex and one of its TWO_OPT_CANDIDATES nearest neighbours are tried
+ * @complexity O(|V|^2) per pass on graphs of up to LARGE_THRESHOLD vertices, and O(|E| * log(k)) to build the candidate
+ * lists and then O(|V| * k) per pass on larger ones (times the cost of a reversal for each improvement), where k is
+ * TWO_OPT_CANDIDATES
+ * @tparam T tour representation (ArrayTour or TwoLevelTour)
+ * @param tour tour to be optimized (including the source vertex)
+ * @param distance double where the distance of the initial tour is stored and where the distance of the optimized
+ * tour will be stored
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
  */
-void TSPGraph::twoOpt(std::vector<int> &path, double &distance){
-    int size = (int) path.size();
+template <typename T>
+void TSPGraph::twoOpt(T &tour, double &distance, Progress *progress){
+    buildMatrix();
+    PROFILE_SCOPE(TWO_OPT);
+
+    int size = countVertices();
+    bool restricted = isLarge();
+
+    std::vector<std::vector<int>> nearest;
+    if (restricted) nearest = candidates(TWO_OPT_CANDIDATES);
+
+    // exact length of the tour, for when a missing edge is removed (as an incremental update would be swallowed by INF)
+    auto length = [this, &tour, size]() {
+        double res = 0;
+
+        for (int v = 1; v <= size; ++v)
+            res += dist(v, tour.next(v));
+
+        return res;
+    };
 
     bool improved = true;
     while (improved){
         improved = false;
 
-        for (int i = 0; i < size - 1; ++i) {
-            for (int j = i + 1; j < size; ++j) {
-                int a = path[i];
-                int b = path[(i + 1) % size];
-                int c = path[j];
-                int d = path[(j + 1) % size];
+        for (int a = 1; a <= size; ++a) {
+            if (Progress::isCancelled(progress)) return;
+
+            // a b ... c d -> a c ... b d  or  b a ... d c -> b d ... a c
+            for (int succ = 1; succ >= 0; --succ) {
+                int b = succ ? tour.next(a) : tour.prev(a);
+                double ab = dist(a, b);
+
+                bool moved = false;
+
+                int count = restricted ? (int) nearest[a].size() : size;
+
+                for (int k = 0; k < count; ++k) {
+                    int c = restricted ? nearest[a][k] : k + 1;
+                    if (c == a) continue;
+
+                    double ac = dist(a, c);
+
+                    // the candidates are sorted, so no other one can lead to a gain (while every vertex is tried
+                    // otherwise, in no particular order)
+                    if (ac >= ab) {
+                        if (restricted) break;
+                        continue;
+                    }
+
+                    int d = succ ? tour.next(c) : tour.prev(c);
+                    if (c == b || d == a) continue;
 
-                // calculate the current distance
-                double currDistance = matrix[a][b] + matrix[c][d];
+                    // calculate the current and the new distance
+                    double currDistance = ab + dist(c, d);
+                    double newDistance = ac + dist(b, d);
 
-                // calculate the new distance
-                double newDistance = matrix[a][c] + matrix[b][d];
+                    // check if the new distance is an optimization (never adding a missing edge, as sums of INF
+                    // saturate and would let the reversals cycle forever)
+                    if (newDistance >= currDistance || newDistance >= INF) continue;
+                    succ ? tour.reverse(b, c) : tour.reverse(a, d);
 
-                // check if the new distance is an optimization
-                if (newDistance >= currDistance) continue;
-                std::reverse(path.begin() + i + 1, path.begin() + j + 1);
+                    distance = (currDistance >= INF) ? length() : distance + newDistance - currDistance;
+                    improved = moved = true;
+                    PROFILE_COUNT(TWO_OPT_MOVES, 1);
 
-                distance += newDistance - currDistance;
-                improved = true;
+                    break; // the reversal may have changed the orientation of the tour
+                }
+
+                if (moved) break;
             }
         }
+
+        PROFILE_COUNT(TWO_OPT_PASSES, 1);
+
+        Progress::improve(progress, distance);
+        Progress::advance(progress, 1);
     }
 }
 
+// the local search is also run from outside (e.g. by the microbenchmarks), so both representations are instantiated
+template void TSPGraph::twoOpt<ArrayTour>(ArrayTour &tour, double &distance, Progress *progress);
+template void TSPGraph::twoOpt<TwoLevelTour>(TwoLevelTour &tour, double &distance, Progress *progress);
+
 /**
- * @brief computes the solution to the TSP problem, using a brute-force backtracking algorithm
+ * @brief computes the solution to the TSP problem, using a brute-force backtracking algorithm, in which the
+ * permutations that start with each vertex are explored in parallel (on the shared ThreadPool), sharing the best bound
  * @complexity O(|V|! * |V|)
- * @param distance double which will be store the distance of the best path
- * @return std::list representing a path, in which each entry contains the index of a vertex and the distance from the
- * previous vertex to it
+ * @param src index of the source vertex
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ * @return Tour representing the best path (or an empty Tour, if the run was cancelled before any was found)
  */
-std::list<std::pair<int, double>> TSPGraph::backtracking(int src){
-    std::list<std::pair<int, double>> bestPath;
-    double minDistance = INF;
+Tour TSPGraph::backtracking(int src, Progress *progress){
+    std::vector<int> bestPath;
+    std::atomic<double> minDistance(INF);
+    std::mutex mutex;
 
-    std::vector<int> indices;
+    std::vector<int> others;
     for (int i = 1; i <= countVertices(); ++i)
-        if (i != src) indices.push_back(i);
+        if (i != src) others.push_back(i);
 
-    if (matrix.empty()) matrix = toMatrix();
+    // compute every distance beforehand, so that the tasks only read the matrix
+    getMatrix();
+    reportBound(progress);
 
-    do {
-        int prev = src;
+    auto explore = [this, src, progress, &others, &bestPath, &minDistance, &mutex](int k) {
+        TRACE_SCOPE("search", k);
 
-        std::list<std::pair<int, double>> currPath;
-        double currDistance = 0;
+        // the first vertex is fixed, while the others are permuted
+        std::vector<int> indices = others;
+        std::rotate(indices.begin(), indices.begin() + k, indices.begin() + k + 1);
 
-        for (int i : indices) {
-            if (matrix[prev][i] < 0)
-                matrix[prev][i] = distance(prev, i);
+        long long permutations = 0, nodes = 0;
 
-            currPath.emplace_back(i, matrix[prev][i]);
-            currDistance += matrix[prev][i];
+        do {
+            // report the work done every once in a while
+            if (!(++permutations & 0xFFFF)) {
+                Progress::advance(progress, 0x10000, nodes);
+                nodes = 0;
 
-            if (currDistance >= minDistance) break;
-            prev = i;
-        }
+                if (Progress::isCancelled(progress)) return;
+            }
+
+            double bound = minDistance.load(std::memory_order_relaxed);
+
+            int prev = src;
+            double currDistance = 0;
+
+            for (int i : indices) {
+                currDistance += dist(prev, i);
+                ++nodes;
+
+                if (currDistance >= bound) break;
+                prev = i;
+            }
+
+            if (currDistance >= bound) continue;
+            currDistance += dist(prev, src);
 
-        if (currDistance >= minDistance) continue;
+            if (currDistance >= bound) continue;
 
-        if (matrix[prev][src] < 0)
-            matrix[prev][src] = distance(prev, src);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (currDistance >= minDistance) continue;
 
-        currPath.emplace_back(src, matrix[prev][src]);
-        currDistance += matrix[prev][src];
+            bestPath = indices;
+            minDistance = currDistance;
 
-        if (currDistance >= minDistance) continue;
+            Progress::improve(progress, currDistance);
+        } while (std::next_permutation(indices.begin() + 1, indices.end()));
 
-        bestPath = currPath;
-        minDistance = currDistance;
-    } while (std::next_permutation(indices.begin(), indices.end()));
+        Progress::advance(progress, permutations & 0xFFFF, nodes);
+    };
 
-    return bestPath;
+    ThreadPool::shared().parallelFor((int) others.size(), explore);
+    if (bestPath.empty() && !others.empty()) return Tour();
+
+    // unless the search was cancelled, the best path is optimal
+    if (progress && !progress->isCancelled()) progress->setBound(minDistance);
+
+    return toTour(src, bestPath);
 }
 
 /**
  * @brief computes an approximation to the TSP problem, using the triangular inequality heuristic
  * @complexity O(|V + E| * log|V|)
- * @param distance double which will be store the distance of the best path
- * @return std::list representing a path, in which each entry contains the index of a vertex and the distance from the
- * previous vertex to it
+ * @param src index of the source vertex
+ * @return Tour representing the computed path
  */
-std::list<std::pair<int, double>> TSPGraph::triangularInequality(int src) {
-    std::list<Edge *> MST = getMST(src);
-    if (matrix.empty()) matrix = toMatrix();
+Tour TSPGraph::triangularInequality(int src) {
+    std::list<Edge *> edges;
+
+    // Prim's algorithm is timed on its own, apart from the preorder traversal
+    {
+        PROFILE_SCOPE(MST);
+        edges = getMST(src);
+    }
+
+    SpanningTree MST(countVertices(), src, edges);
+    buildMatrix();
+
+    // compute the path by visiting the MST in preorder
+    std::vector<int> order = MST.preorder();
+    return toTour(src, std::vector<int>(order.begin() + 1, order.end()));
+}
+
+/**
+ * @brief implementation of the Nearest-Neighbour algorithm, which yields an approximation for the TSP
+ * @complexity O(|V|^2)
+ * @param src index of the source vertex
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ * @return Tour representing the computed path
+ */
+Tour TSPGraph::other(int src, Progress *progress) {
+    buildMatrix();
 
     // set up the algorithm
-    for (Edge *e: edges)
-        e->valid = false;
+    resetAll();
+
+    // execute Nearest-Neighbours to obtain the initial path
+    double distance;
+    std::vector<int> initialPath = nearestNeighbours(src, distance);
+
+    // use 2-opt to optimize the whole cycle, including the edges adjacent to the source
+    initialPath.insert(initialPath.begin(), src);
+    distance += dist(initialPath.back(), src);
+    Progress::improve(progress, distance);
 
-    for (Edge *e: MST) {
-        e->valid = true;
-        (*this)[e->getSrc()].valid = true;
+    if (isLarge()) {
+        TwoLevelTour tour(initialPath);
+        twoOpt(tour, distance, progress);
+
+        return cycleToTour(src, tour.toVector(src));
     }
 
-    // compute the path using DFS
-    std::list<std::pair<int, double>> path;
-    double (TSPGraph::*dist)(int, int) = isReal ? &TSPGraph::haversine : &TSPGraph::distance;
+    ArrayTour tour(initialPath);
+    twoOpt(tour, distance, progress);
 
-    std::stack<int> s;
-    s.push(src);
+    return cycleToTour(src, tour.toVector(src));
+}
 
-    (*this)[src].valid = false;
-    int prev = src;
+/**
+ * @brief computes an approximation to the TSP problem, using one of the metaheuristics (simulated annealing, parallel
+ * tempering, iterated local search or ant colony optimization) to escape the local optimum found by the
+ * Nearest-Neighbour + 2-opt heuristic
+ * @tparam Solver class of the metaheuristic, built from the distance matrix, its Config and the Progress
+ * @param src index of the source vertex
+ * @param timeLimit time limit (in seconds, 0 uses the default of the metaheuristic)
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ * @return Tour representing the computed path
+ */
+template <typename Solver>
+Tour TSPGraph::improve(int src, double timeLimit, Progress *progress) {
+    typename Solver::Config config;
+    if (timeLimit > 0) config.timeLimit = timeLimit;
 
-    while (!s.empty()) {
-        int curr = s.top();
-        s.pop();
+    std::vector<int> order = other(src, progress).getOrder();
+    reportBound(progress);
 
-        for (const Edge *e: (*this)[curr].outEdges()) {
-            int next = e->getDest();
-            if (!e->valid || !(*this)[next].valid) continue;
+    Solver(getMatrix(), config, progress).run(order);
+    return cycleToTour(src, order);
+}
 
-            s.push(next);
-            (*this)[next].valid = false;
-        }
+/**
+ * @brief computes an approximation to the TSP problem, using a genetic algorithm (order crossover followed by 2-opt)
+ * whose population is seeded with Nearest-Neighbour tours from different starting vertices
+ * @param src index of the source vertex
+ * @param timeLimit time limit (in seconds, 0 uses the default of the genetic algorithm)
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ * @return Tour representing the computed path
+ */
+Tour TSPGraph::genetic(int src, double timeLimit, Progress *progress) {
+    GeneticAlgorithm::Config config;
+    if (timeLimit > 0) config.timeLimit = timeLimit;
 
-        if (curr == prev) continue;
+    const DistanceMatrix &distances = getMatrix();
+    reportBound(progress);
 
-        if (matrix[prev][curr] < 0)
-            matrix[prev][curr] = (this->*dist)(prev, curr);
+    // compute the seeds, starting at the source and then at the other vertices
+    int count = std::min(countVertices(), config.populationSize);
+    std::vector<std::vector<int>> seeds;
 
-        path.emplace_back(curr, matrix[prev][curr]);
-        prev = curr;
+    for (int i = 0; i < count; ++i) {
+        int start = (src + i - 1) % countVertices() + 1;
+        resetAll();
+
+        double distance;
+        std::vector<int> seed = nearestNeighbours(start, distance);
+
+        seed.insert(seed.begin(), start);
+        seeds.push_back(std::move(seed));
     }
 
-    if (matrix[prev][src] < 0)
-        matrix[prev][src] = (this->*dist)(prev, src);
+    std::vector<int> order;
+    GeneticAlgorithm(distances, config, progress).run(seeds, order);
 
-    path.emplace_back(src, matrix[prev][src]);
-    return path;
+    return cycleToTour(src, order);
 }
 
 /**
- * @brief implementation of the Nearest-Neighbour algorithm, which yields an approximation for the TSP
- * @complexity O(|V|^2)
+ * @brief returns the names of the TSP algorithms that can be run by name
+ * @return std::vector containing the names of the algorithms
+ */
+const std::vector<std::string> &TSPGraph::algorithms() {
+    static const std::vector<std::string> names = {"backtracking", "triangular", "other", "annealing", "tempering",
+                                                   "ils", "genetic", "ants"};
+    return names;
+}
+
+/**
+ * @brief indicates if there is a TSP algorithm with a given name
+ * @param name name of the algorithm
+ * @return 'true' if the algorithm exists, 'false' otherwise
+ */
+bool TSPGraph::isAlgorithm(const std::string &name) {
+    const std::vector<std::string> &names = algorithms();
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+/**
+ * @brief runs one of the TSP algorithms, chosen by name, with a given time limit
+ * @note the time limit of the algorithms that do not have their own (backtracking and other) is enforced by
+ * cancelling them through the Progress, once it runs out
+ * @param algorithm name of the algorithm
  * @param src index of the source vertex
- * @return std::list representing a path, in which each entry contains the index of a vertex and the distance from the
- * previous vertex to it
+ * @param timeLimit time limit (in seconds, 0 uses the default of the algorithm)
+ * @param progress channel through which the best length is reported and the run is cancelled
+ * @return Tour representing the computed path (or an empty Tour, if the algorithm does not exist)
  */
-std::list<std::pair<int, double>> TSPGraph::other(int src) {
-    if (matrix.empty()) matrix = toMatrix();
+Tour TSPGraph::run(const std::string &algorithm, int src, double timeLimit, Progress &progress) {
+    if (algorithm == "backtracking" || algorithm == "other") {
+        if (timeLimit > 0) progress.setDeadline(timeLimit);
+        return (algorithm == "other") ? other(src, &progress) : backtracking(src, &progress);
+    }
 
-    // set up the algorithm
-    resetAll();
+    if (algorithm == "triangular") return triangularInequality(src);
 
-    // execute Nearest-Neighbours to obtain the initial path
-    double distance;
-    std::vector<int> initialPath = nearestNeighbours(src, distance);
+    if (algorithm == "annealing") return improve<SimulatedAnnealing>(src, timeLimit, &progress);
+    if (algorithm == "tempering") return improve<ParallelTempering>(src, timeLimit, &progress);
+    if (algorithm == "ils") return improve<IteratedLocalSearch>(src, timeLimit, &progress);
+    if (algorithm == "genetic") return genetic(src, timeLimit, &progress);
+    if (algorithm == "ants") return improve<AntColony>(src, timeLimit, &progress);
 
-    // use 2-opt to optimize the path
-    twoOpt(initialPath, distance);
+    return Tour();
+}
+
+/**
+ * @brief runs one of the TSP algorithms, chosen by name, unless the same algorithm (with the same time limit) has
+ * already been run on a graph with the same distances, in which case its tour is rotated to start at the source
+ * @note large graphs are never looked up in the cache, as their fingerprint would need the whole distance matrix
+ * @complexity O(|V|^2) the first time the graph is fingerprinted and O(|V|) for a cached tour
+ * @param algorithm name of the algorithm
+ * @param src index of the source vertex
+ * @param timeLimit time limit (in seconds, 0 uses the default of the algorithm)
+ * @param progress channel through which the best length is reported and the run is cancelled
+ * @param cache SolutionCache where the tours are looked up and stored (nullptr always runs the algorithm)
+ * @return Tour representing the computed path (or an empty Tour, if the algorithm does not exist)
+ */
+Tour TSPGraph::solve(const std::string &algorithm, int src, double timeLimit, Progress &progress,
+                     SolutionCache *cache) {
+    if (!cache || !isAlgorithm(algorithm) || isLarge()) return run(algorithm, src, timeLimit, progress);
 
-    // compute the final path
-    std::list<std::pair<int, double>> path;
+    SolutionCache::Entry entry;
 
-    int curr = src;
-    for (int i : initialPath) {
-        path.emplace_back(i, matrix[curr][i]);
-        curr = i;
+    if (cache->find(fingerprint(), algorithm, timeLimit, entry)) {
+        Tour tour = cycleToTour(src, entry.cycle);
+
+        progress.improve(tour.getLength());
+        progress.setBound(entry.bound);
+
+        return tour;
     }
 
-    path.emplace_back(src, matrix[curr][src]);
-    return path;
+    Tour tour = run(algorithm, src, timeLimit, progress);
+
+    // a cancelled run is cut short, so its tour must not be reused
+    if (tour.hasDistances() && tour.size() == countVertices() && !progress.isCancelled()) {
+        double bound = progress.snapshot().bound;
+        cache->store(fingerprint(), algorithm, timeLimit, {tour.getOrder(), tour.getLength(), bound});
+    }
+
+    return tour;
 }
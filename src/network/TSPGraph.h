@@ -1,19 +1,31 @@
 #ifndef DA_PROJ2_TSPGRAPH
 #define DA_PROJ2_TSPGRAPH
 
-#include <list>
+#include <cstdint>
+#include <string>
 #include <vector>
 
+#include "DistanceMatrix.h"
 #include "Place.hpp"
+#include "Tour.h"
 #include "UGraph.h"
+#include "../solvers/AntColony.h"
+#include "../solvers/GeneticAlgorithm.h"
+#include "../solvers/HeldKarp.h"
+#include "../solvers/IteratedLocalSearch.h"
+#include "../solvers/ParallelTempering.h"
+#include "../solvers/SimulatedAnnealing.h"
+#include "../utils/Progress.h"
+#include "../utils/SolutionCache.h"
 
 using std::vector;
 
 class TSPGraph : public UGraph {
 /* ATTRIBUTES */
 private:
-    vector<vector<double>> matrix;
+    DistanceMatrix matrix;
     bool isReal;
+    uint64_t hash;              // fingerprint of the distances (0 until it is computed)
 
 /* CONSTRUCTOR */
 public:
@@ -22,14 +34,38 @@ public:
 /* METHODS */
 private:
     double haversine(int src, int dest);
+    double computeDistance(int src, int dest);
+    bool isLarge();
+    void buildMatrix();
+    double dist(int src, int dest);
+    std::vector<std::vector<int>> candidates(int k);
+    Tour toTour(int src, const std::vector<int> &path);
+    Tour cycleToTour(int src, const std::vector<int> &cycle);
     std::vector<int> nearestNeighbours(int src, double &distance);
-    void twoOpt(std::vector<int> &path, double &distance);
+    void reportBound(Progress *progress);
+    template <typename Solver> Tour improve(int src, double timeLimit, Progress *progress);
+    Tour genetic(int src, double timeLimit, Progress *progress);
+    Tour run(const std::string &algorithm, int src, double timeLimit, Progress &progress);
 
 public:
+    static double haversine(const Place &lhs, const Place &rhs);
+    template <typename T> void twoOpt(T &tour, double &distance, Progress *progress = nullptr);
+
+    void setMatrixCache(const std::string &path, uint64_t key);
+    void persistMatrix();
+    const DistanceMatrix &getMatrix();
+    uint64_t fingerprint();
+    double lowerBound(const HeldKarp::Config &config = HeldKarp::Config(), double upperBound = 0);
+
     // TSP algorithms
-    std::list<std::pair<int, double>> backtracking(int src);
-    std::list<std::pair<int, double>> triangularInequality(int src);
-    std::list<std::pair<int, double>> other(int src);
+    Tour backtracking(int src, Progress *progress = nullptr);
+    Tour triangularInequality(int src);
+    Tour other(int src, Progress *progress = nullptr);
+
+    static const std::vector<std::string> &algorithms();
+    static bool isAlgorithm(const std::string &name);
+    Tour solve(const std::string &algorithm, int src, double timeLimit, Progress &progress,
+               SolutionCache *cache = nullptr);
 };
 
 #endif
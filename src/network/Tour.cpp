@@ -0,0 +1,158 @@
+#include <iterator>
+
+#include "Tour.h"
+
+/**
+ * @brief creates a new, empty Tour
+ */
+Tour::Tour() : length(0) {}
+
+/**
+ * @brief creates a new Tour which, for now, only contains the source vertex
+ * @param src index of the source vertex
+ * @param size number of vertices the Tour will have (used to allocate all the memory at once)
+ */
+Tour::Tour(int src, int size) : length(0) {
+    order.reserve(size);
+    cumulative.reserve(size);
+
+    order.push_back(src);
+}
+
+/**
+ * @brief creates a new Tour from the order of its vertices, without the distance of each leg
+ * @param order vertices in the order they are visited, starting at the source
+ * @param length total distance of the Tour
+ */
+Tour::Tour(std::vector<int> order, double length) : order(std::move(order)), length(length) {}
+
+/**
+ * @brief appends a vertex to the Tour
+ * @param v index of the vertex
+ * @param distance distance from the previous vertex to the new one
+ */
+void Tour::add(int v, double distance) {
+    order.push_back(v);
+
+    length += distance;
+    cumulative.push_back(length);
+}
+
+/**
+ * @brief closes the Tour, by adding the leg from the last vertex back to the source
+ * @param distance distance from the last vertex to the source
+ */
+void Tour::close(double distance) {
+    length += distance;
+    cumulative.push_back(length);
+}
+
+/**
+ * @brief returns the index of the source vertex
+ * @return index of the source vertex
+ */
+int Tour::getSource() const {
+    return order.front();
+}
+
+/**
+ * @brief returns the number of vertices of the Tour
+ * @return number of vertices of the Tour
+ */
+int Tour::size() const {
+    return (int) order.size();
+}
+
+/**
+ * @brief indicates if the Tour has no vertices
+ * @return 'true' if the Tour is empty, 'false' otherwise
+ */
+bool Tour::empty() const {
+    return order.empty();
+}
+
+/**
+ * @brief returns the i-th vertex of the Tour
+ * @param i position of the vertex in the Tour
+ * @return index of the vertex
+ */
+int Tour::operator[](int i) const {
+    return order[i];
+}
+
+/**
+ * @brief returns the vertices of the Tour, in the order they are visited
+ * @return std::vector containing the indices of the vertices
+ */
+const std::vector<int> &Tour::getOrder() const {
+    return order;
+}
+
+/**
+ * @brief returns the total distance of the Tour
+ * @return total distance of the Tour
+ */
+double Tour::getLength() const {
+    return length;
+}
+
+/**
+ * @brief indicates if the distance of each leg of the Tour is known
+ * @return 'true' if the distances are known, 'false' otherwise
+ */
+bool Tour::hasDistances() const {
+    return !order.empty() && cumulative.size() == order.size();
+}
+
+/**
+ * @brief returns the distance of the i-th leg of the Tour, i.e. from the i-th vertex to the next one
+ * @param i index of the leg
+ * @return distance of the leg
+ */
+double Tour::getDistance(int i) const {
+    return i ? cumulative[i] - cumulative[i - 1] : cumulative[0];
+}
+
+/**
+ * @brief returns the distance travelled after the i-th leg of the Tour
+ * @param i index of the leg
+ * @return distance travelled since the source
+ */
+double Tour::getCumulativeDistance(int i) const {
+    return cumulative[i];
+}
+
+/**
+ * @brief converts the Tour to a list, in which each entry contains the index of a vertex and the distance from the
+ * previous vertex to it (the last entry is the return to the source)
+ * @complexity O(|V|)
+ * @return std::list representing the Tour
+ */
+std::list<std::pair<int, double>> Tour::toList() const {
+    std::list<std::pair<int, double>> path;
+    if (!hasDistances()) return path;
+
+    for (int i = 0; i < size(); ++i)
+        path.emplace_back(order[(i + 1) % size()], getDistance(i));
+
+    return path;
+}
+
+/**
+ * @brief creates a Tour from a list, in which each entry contains the index of a vertex and the distance from the
+ * previous vertex to it (the last entry is the return to the source)
+ * @complexity O(|V|)
+ * @param src index of the source vertex
+ * @param path std::list representing the Tour
+ * @return Tour
+ */
+Tour Tour::fromList(int src, const std::list<std::pair<int, double>> &path) {
+    Tour tour(src, (int) path.size());
+    if (path.empty()) return tour;
+
+    for (auto it = path.begin(); it != std::prev(path.end()); ++it)
+        tour.add(it->first, it->second);
+
+    tour.close(path.back().second);
+    return tour;
+}
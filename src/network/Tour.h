@@ -0,0 +1,41 @@
+#ifndef DA_PROJ2_TOUR_H
+#define DA_PROJ2_TOUR_H
+
+#include <list>
+#include <utility>
+#include <vector>
+
+class Tour {
+/* ATTRIBUTES */
+private:
+    std::vector<int> order;         // vertices in the order they are visited, starting at the source
+    std::vector<double> cumulative; // distance travelled after each leg (optional)
+    double length;
+
+/* CONSTRUCTORS */
+public:
+    Tour();
+    explicit Tour(int src, int size = 0);
+    Tour(std::vector<int> order, double length);
+
+/* METHODS */
+public:
+    void add(int v, double distance);
+    void close(double distance);
+
+    int getSource() const;
+    int size() const;
+    bool empty() const;
+    int operator[](int i) const;
+    const std::vector<int> &getOrder() const;
+    double getLength() const;
+    bool hasDistances() const;
+    double getDistance(int i) const;
+    double getCumulativeDistance(int i) const;
+
+    // compatibility with the previous representation
+    std::list<std::pair<int, double>> toList() const;
+    static Tour fromList(int src, const std::list<std::pair<int, double>> &path);
+};
+
+#endif //DA_PROJ2_TOUR_H
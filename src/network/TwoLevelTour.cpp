@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cmath>
+
+#include "TwoLevelTour.h"
+
+/**
+ * @brief creates a new TwoLevelTour, a tour split into about sqrt(|V|) segments, each with a reversal bit
+ * @complexity O(|V|)
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ */
+TwoLevelTour::TwoLevelTour(const std::vector<int> &order) : n((int) order.size()) {
+    segment.resize(*std::max_element(order.begin(), order.end()) + 1, -1);
+    index.resize(segment.size(), -1);
+
+    build(order);
+}
+
+/**
+ * @brief splits the tour into segments of (roughly) equal size
+ * @complexity O(|V|)
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ */
+void TwoLevelTour::build(const std::vector<int> &order) {
+    int groupSize = std::max(1, (int) std::sqrt(n));
+    int count = (n + groupSize - 1) / groupSize;
+
+    segments.assign(count, Segment());
+    maxSegments = 2 * count + 2;
+
+    for (int s = 0; s < count; ++s) {
+        Segment &seg = segments[s];
+
+        seg.reversed = false;
+        seg.next = (s + 1) % count;
+        seg.prev = (s - 1 + count) % count;
+        seg.rank = s;
+
+        for (int i = s * groupSize; i < std::min(n, (s + 1) * groupSize); ++i) {
+            segment[order[i]] = s;
+            index[order[i]] = (int) seg.vertices.size();
+            seg.vertices.push_back(order[i]);
+        }
+    }
+}
+
+/**
+ * @brief recomputes the rank of each segment, by walking through them in tour order
+ * @complexity O(sqrt(|V|))
+ */
+void TwoLevelTour::renumber() {
+    int s = 0, rank = 0;
+
+    do {
+        segments[s].rank = rank++;
+        s = segments[s].next;
+    } while (s);
+}
+
+/**
+ * @brief returns the first vertex of a segment, in tour order
+ * @param s index of the segment
+ * @return index of the vertex
+ */
+int TwoLevelTour::first(int s) const {
+    const Segment &seg = segments[s];
+    return seg.reversed ? seg.vertices.back() : seg.vertices.front();
+}
+
+/**
+ * @brief returns the last vertex of a segment, in tour order
+ * @param s index of the segment
+ * @return index of the vertex
+ */
+int TwoLevelTour::last(int s) const {
+    const Segment &seg = segments[s];
+    return seg.reversed ? seg.vertices.front() : seg.vertices.back();
+}
+
+/**
+ * @brief splits the segment of a vertex, so that the vertex becomes the first of its segment
+ * @complexity O(sqrt(|V|))
+ * @param v index of the vertex
+ */
+void TwoLevelTour::splitBefore(int v) {
+    int s = segment[v], k = offset(v);
+    if (!k) return;
+
+    // lay out the segment in tour order
+    std::vector<int> vertices = segments[s].vertices;
+    if (segments[s].reversed) std::reverse(vertices.begin(), vertices.end());
+
+    int t = (int) segments.size();
+    segments.emplace_back();
+
+    Segment &head = segments[s], &tail = segments[t];
+    head.vertices.assign(vertices.begin(), vertices.begin() + k);
+    tail.vertices.assign(vertices.begin() + k, vertices.end());
+    head.reversed = tail.reversed = false;
+
+    // link the new segment after the old one
+    tail.next = head.next;
+    tail.prev = s;
+    segments[head.next].prev = t;
+    head.next = t;
+
+    for (int i = 0; i < (int) head.vertices.size(); ++i)
+        index[head.vertices[i]] = i;
+
+    for (int i = 0; i < (int) tail.vertices.size(); ++i) {
+        segment[tail.vertices[i]] = t;
+        index[tail.vertices[i]] = i;
+    }
+}
+
+/**
+ * @brief splits the segment of a vertex, so that the vertex becomes the last of its segment
+ * @complexity O(sqrt(|V|))
+ * @param v index of the vertex
+ */
+void TwoLevelTour::splitAfter(int v) {
+    if (v != last(segment[v])) splitBefore(next(v));
+}
+
+/**
+ * @brief returns the number of vertices of the tour
+ * @return number of vertices of the tour
+ */
+int TwoLevelTour::size() const {
+    return n;
+}
+
+/**
+ * @brief checks if a vertex lies on the path that goes from one vertex to another
+ * @complexity O(1)
+ * @param a index of the first vertex of the path
+ * @param b index of the vertex to be checked
+ * @param c index of the last vertex of the path
+ * @return 'true' if b is visited when going from a to c, 'false' otherwise
+ */
+bool TwoLevelTour::between(int a, int b, int c) const {
+    long long i = (long long) segments[segment[a]].rank * n + offset(a);
+    long long j = (long long) segments[segment[b]].rank * n + offset(b);
+    long long k = (long long) segments[segment[c]].rank * n + offset(c);
+
+    return (i <= k) ? (i <= j && j <= k) : (j >= i || j <= k);
+}
+
+/**
+ * @brief reverses the path that goes from one vertex to another, by splitting the segments at its ends and then
+ * reversing the order (and flipping the reversal bits) of the segments in between
+ * @note the complementary path is reversed instead if it spans fewer segments, which yields the same cycle
+ * @complexity O(sqrt(|V|)) amortized
+ * @param from index of the first vertex of the path
+ * @param to index of the last vertex of the path
+ */
+void TwoLevelTour::reverse(int from, int to) {
+    if (from == to || next(to) == from) return;
+
+    // reverse the side that spans fewer segments
+    int count = (int) segments.size();
+    int span = segments[segment[to]].rank - segments[segment[from]].rank;
+
+    if (span < 0 || (!span && offset(to) < offset(from))) span += count;
+
+    if (2 * span > count) {
+        int temp = from;
+        from = next(to);
+        to = prev(temp);
+    }
+
+    splitBefore(from);
+    splitAfter(to);
+
+    int sf = segment[from], st = segment[to];
+    int before = segments[sf].prev, after = segments[st].next;
+
+    // flip every segment of the path
+    for (int s = sf;; s = segments[s].prev) {
+        Segment &seg = segments[s];
+
+        seg.reversed = !seg.reversed;
+        std::swap(seg.next, seg.prev);
+
+        if (s == st) break;
+    }
+
+    segments[before].next = st;
+    segments[st].prev = before;
+    segments[sf].next = after;
+    segments[after].prev = sf;
+
+    // splitting leaves ever smaller segments behind, so rebalance once there are too many of them
+    if ((int) segments.size() > maxSegments) build(toVector(first(0)));
+    else renumber();
+}
+
+/**
+ * @brief returns the vertices of the tour, in the order they are visited
+ * @complexity O(|V|)
+ * @param start index of the vertex the tour should start at
+ * @return std::vector containing the indices of the vertices in the order they are visited
+ */
+std::vector<int> TwoLevelTour::toVector(int start) const {
+    std::vector<int> res;
+    res.reserve(n);
+
+    int v = start;
+    do {
+        res.push_back(v);
+        v = next(v);
+    } while (v != start);
+
+    return res;
+}
@@ -0,0 +1,79 @@
+#ifndef DA_PROJ2_TWOLEVELTOUR_H
+#define DA_PROJ2_TWOLEVELTOUR_H
+
+#include <vector>
+
+class TwoLevelTour {
+/* ATTRIBUTES */
+private:
+    struct Segment {
+        std::vector<int> vertices; // vertices of the segment, in storage order
+        bool reversed;             // indicates if the segment is traversed in the opposite storage order
+        int next, prev;            // neighbouring segments in the tour
+        int rank;                  // position of the segment in the tour
+    };
+
+    std::vector<Segment> segments;
+    std::vector<int> segment;      // segment of each vertex
+    std::vector<int> index;        // index of each vertex in the storage of its segment
+    int n, maxSegments;
+
+/* CONSTRUCTOR */
+public:
+    explicit TwoLevelTour(const std::vector<int> &order);
+
+/* METHODS */
+private:
+    void build(const std::vector<int> &order);
+    void renumber();
+
+    /**
+     * @brief returns the position of a vertex within its segment, in tour order
+     * @param v index of the vertex
+     * @return position of the vertex within its segment
+     */
+    int offset(int v) const {
+        const Segment &s = segments[segment[v]];
+        return s.reversed ? (int) s.vertices.size() - 1 - index[v] : index[v];
+    }
+
+    int first(int s) const;
+    int last(int s) const;
+    void splitBefore(int v);
+    void splitAfter(int v);
+
+public:
+    int size() const;
+
+    /**
+     * @brief returns the vertex that is visited after a given vertex
+     * @param v index of the vertex
+     * @return index of the next vertex
+     */
+    int next(int v) const {
+        const Segment &s = segments[segment[v]];
+        int i = index[v] + (s.reversed ? -1 : 1);
+
+        if (i < 0 || i == (int) s.vertices.size()) return first(s.next);
+        return s.vertices[i];
+    }
+
+    /**
+     * @brief returns the vertex that is visited before a given vertex
+     * @param v index of the vertex
+     * @return index of the previous vertex
+     */
+    int prev(int v) const {
+        const Segment &s = segments[segment[v]];
+        int i = index[v] + (s.reversed ? 1 : -1);
+
+        if (i < 0 || i == (int) s.vertices.size()) return last(s.prev);
+        return s.vertices[i];
+    }
+
+    bool between(int a, int b, int c) const;
+    void reverse(int from, int to);
+    std::vector<int> toVector(int start) const;
+};
+
+#endif //DA_PROJ2_TWOLEVELTOUR_H
@@ -0,0 +1,195 @@
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "ThreadPool.h"
+#include "../utils/Tracer.h"
+
+int ThreadPool::sharedSize = 0;
+bool ThreadPool::sharedPinning = false;
+
+/**
+ * @brief creates a new work-stealing ThreadPool, in which each worker has its own task deque
+ * @param size number of workers (0 uses one per hardware thread)
+ * @param pinning indicates if each worker should be pinned to its own CPU
+ */
+ThreadPool::ThreadPool(int size, bool pinning) : pending(0), nextWorker(0), stopping(false) {
+    if (size <= 0) size = (int) std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 0; i < size; ++i)
+        workers.emplace_back(new Worker());
+
+    for (int i = 0; i < size; ++i) {
+        threads.emplace_back(&ThreadPool::loop, this, i);
+        if (pinning) pin(threads.back(), i);
+    }
+}
+
+/**
+ * @brief stops the workers, after they have executed every pending task
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (std::thread &t : threads)
+        t.join();
+}
+
+/**
+ * @brief returns the worker running on the calling thread
+ * @return reference to the pool and index of the worker (the pool is nullptr if the calling thread is not a worker)
+ */
+std::pair<const ThreadPool *, int> &ThreadPool::current() {
+    thread_local std::pair<const ThreadPool *, int> worker(nullptr, -1);
+    return worker;
+}
+
+/**
+ * @brief returns the index of the worker of this pool that is running on the calling thread
+ * @return index of the worker (-1 if the calling thread is not a worker of this pool)
+ */
+int ThreadPool::currentWorker() const {
+    return (current().first == this) ? current().second : -1;
+}
+
+/**
+ * @brief pushes a task to the deque of the calling worker or, if the calling thread is not a worker, to the deque of
+ * the next worker (in round-robin order)
+ * @param task function to be executed
+ */
+void ThreadPool::push(std::function<void()> task) {
+    int index = currentWorker();
+    if (index < 0) index = (int) (nextWorker++ % workers.size());
+
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        ++pending;
+    }
+
+    wake.notify_one();
+}
+
+/**
+ * @brief executes one pending task, taking it from the deque of the calling worker or stealing it from another one
+ * @return 'true' if a task was executed, 'false' if there were no pending tasks
+ */
+bool ThreadPool::runPending() {
+    int size = (int) workers.size(), self = currentWorker();
+    std::function<void()> task;
+
+    // the calling worker takes its most recent task, while the other deques are stolen from in FIFO order
+    for (int k = 0; k < size && !task; ++k) {
+        int i = (self < 0) ? k : (self + k) % size;
+        Worker &worker = *workers[i];
+
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) continue;
+
+        if (i == self) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        }
+        else {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+    }
+
+    if (!task) return false;
+
+    --pending;
+
+    TRACE_SCOPE("task");
+    task();
+
+    return true;
+}
+
+/**
+ * @brief executes tasks until the pool is stopped, sleeping whenever there are none
+ * @param index index of the worker
+ */
+void ThreadPool::loop(int index) {
+    current() = std::make_pair(this, index);
+    Tracer::nameThread("worker " + std::to_string(index));
+
+    while (true) {
+        if (runPending()) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || pending > 0; });
+
+        if (stopping && pending <= 0) break;
+    }
+}
+
+/**
+ * @brief pins a thread to a CPU, out of the ones the process is allowed to run on (e.g. within its cpuset)
+ * @param thread thread to be pinned
+ * @param cpu index of the CPU among the allowed ones (wraps around them)
+ */
+void ThreadPool::pin(std::thread &thread, int cpu) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) return;
+
+    int count = CPU_COUNT(&allowed);
+    if (count == 0) return;
+
+    cpu %= count;
+
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+        if (!CPU_ISSET(i, &allowed) || cpu--) continue;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(i, &set);
+
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+        return;
+    }
+#else
+    (void) thread;
+    (void) cpu;
+#endif
+}
+
+/**
+ * @brief sets the configuration of the shared ThreadPool
+ * @note it only has effect if it is called before the shared ThreadPool is used for the first time
+ * @param size number of workers (0 uses one per hardware thread)
+ * @param pinning indicates if each worker should be pinned to its own CPU
+ */
+void ThreadPool::configure(int size, bool pinning) {
+    sharedSize = size;
+    sharedPinning = pinning;
+}
+
+/**
+ * @brief returns the ThreadPool shared by every parallel solver, so that running several of them at once does not
+ * oversubscribe the CPUs
+ * @return reference to the shared ThreadPool
+ */
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool(sharedSize, sharedPinning);
+    return pool;
+}
+
+/**
+ * @brief returns the number of workers of the ThreadPool
+ * @return number of workers
+ */
+int ThreadPool::size() const {
+    return (int) workers.size();
+}
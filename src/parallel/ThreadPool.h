@@ -0,0 +1,126 @@
+#ifndef DA_PROJ2_THREADPOOL_H
+#define DA_PROJ2_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class ThreadPool {
+/* ATTRIBUTES */
+private:
+    struct Worker {
+        std::deque<std::function<void()>> tasks; // the owner pops from the back, thieves steal from the front
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<int> pending;
+    std::atomic<unsigned> nextWorker;
+    std::atomic<bool> stopping;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    static int sharedSize;
+    static bool sharedPinning;
+
+/* CONSTRUCTOR */
+public:
+    explicit ThreadPool(int size = 0, bool pinning = false);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+/* METHODS */
+private:
+    static std::pair<const ThreadPool *, int> &current();
+    int currentWorker() const;
+    void push(std::function<void()> task);
+    bool runPending();
+    void loop(int index);
+    static void pin(std::thread &thread, int cpu);
+
+public:
+    static void configure(int size, bool pinning);
+    static ThreadPool &shared();
+
+    int size() const;
+
+    /**
+     * @brief schedules a task to be executed by one of the workers
+     * @param task function to be executed
+     * @return std::future that will hold the result of the task
+     */
+    template <typename F>
+    std::future<typename std::result_of<F()>::type> submit(F task) {
+        using R = typename std::result_of<F()>::type;
+
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::move(task));
+        std::future<R> res = packaged->get_future();
+
+        push([packaged]() { (*packaged)(); });
+        return res;
+    }
+
+    /**
+     * @brief waits for a task to finish, executing other pending tasks in the meantime (which prevents deadlocks
+     * when a task waits for the tasks it submitted)
+     * @param future std::future of the task
+     * @return result of the task
+     */
+    template <typename R>
+    R wait(std::future<R> &future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!runPending()) future.wait_for(std::chrono::microseconds(100));
+        }
+
+        return future.get();
+    }
+
+    /**
+     * @brief executes a function for every index in [0, count[, in parallel, and waits for all of them to finish
+     * @note if any call throws, the first exception is only rethrown once every submitted call has finished, as they
+     * all refer to f (and usually to the locals of the caller)
+     * @param count number of indices
+     * @param f function to be executed for each index
+     */
+    template <typename F>
+    void parallelFor(int count, F f) {
+        std::vector<std::future<void>> futures;
+        std::exception_ptr error;
+
+        try {
+            futures.reserve(count);
+
+            for (int i = 0; i < count; ++i)
+                futures.push_back(submit([&f, i]() { f(i); }));
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        for (std::future<void> &future : futures) {
+            try {
+                wait(future);
+            }
+            catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+#endif //DA_PROJ2_THREADPOOL_H
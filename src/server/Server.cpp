@@ -0,0 +1,465 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "Server.h"
+#include "../parallel/ThreadPool.h"
+#include "../utils/Reader.h"
+#include "../utils/ResultWriter.h"
+
+// maximum size of a request (in bytes)
+#define MAX_REQUEST (1 << 20)
+
+using std::cerr;
+using std::endl;
+
+/**
+ * @brief creates a new Server, which keeps graphs resident in memory and solves them on request, over a UNIX socket
+ */
+Server::Server() : detectHeader(true), hasHeader(true), cache(true), listener(-1), stopping(false),
+                   solving(0) {}
+
+/**
+ * @brief prints the command-line options and the protocol of the server
+ * @param out stream where the options will be printed
+ */
+void Server::usage(std::ostream &out) {
+    out << "Usage: DA_Proj2 --serve SOCKET [--header | --no-header] [--no-cache] [--matrix-cache DIR] [--threads N]"
+        << endl << "                                  [--pin]" << endl << endl
+        << "Listens on a UNIX socket, keeping every graph it loads resident in memory. Each message (in either"
+        << endl << "direction) is a 4-byte big-endian length followed by that many bytes. Unless '--no-cache' is given,"
+        << endl << "a repeated solve (even from another source) reuses the tour of the first one. The requests are:"
+        << endl << endl
+        << "  load <graph>                                   loads a graph (if it is not resident yet)" << endl
+        << "  solve <graph> <algorithm> [source] [time]      runs an algorithm, answering with a JSON result" << endl
+        << "  unload <graph>                                 removes a graph from memory" << endl
+        << "  list                                           lists the resident graphs" << endl
+        << "  shutdown                                       stops the server" << endl;
+}
+
+/**
+ * @brief reads a length-prefixed message from a socket
+ * @param fd socket
+ * @param message string where the message will be stored
+ * @return 'true' if a whole message was read, 'false' if the connection was closed or the message is too long
+ */
+bool Server::readMessage(int fd, string &message) {
+    auto readAll = [fd](char *data, size_t size) {
+        while (size) {
+            ssize_t count = recv(fd, data, size, 0);
+
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) return false;
+
+            data += count;
+            size -= (size_t) count;
+        }
+
+        return true;
+    };
+
+    unsigned char prefix[4];
+    if (!readAll((char *) prefix, 4)) return false;
+
+    uint32_t size = (uint32_t) prefix[0] << 24 | (uint32_t) prefix[1] << 16 | (uint32_t) prefix[2] << 8 | prefix[3];
+    if (size > MAX_REQUEST) return false;
+
+    message.resize(size);
+    return readAll(&message[0], size);
+}
+
+/**
+ * @brief writes a length-prefixed message to a socket
+ * @param fd socket
+ * @param message message to be written
+ * @return 'true' if the whole message was written, 'false' otherwise
+ */
+bool Server::writeMessage(int fd, const string &message) {
+    auto size = (uint32_t) message.size();
+    string data = {(char) (size >> 24), (char) (size >> 16), (char) (size >> 8), (char) size};
+    data += message;
+
+    const char *it = data.data();
+    size_t left = data.size();
+
+    while (left) {
+        // MSG_NOSIGNAL avoids a SIGPIPE if the client has gone away
+        ssize_t count = send(fd, it, left, MSG_NOSIGNAL);
+
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+
+        it += count;
+        left -= (size_t) count;
+    }
+
+    return true;
+}
+
+/**
+ * @brief creates the response to a request that failed
+ * @param message description of the error
+ * @return JSON object with the error
+ */
+string Server::error(const string &message) {
+    return "{\"error\":" + ResultWriter::quote(message, ResultWriter::JSON) + "}\n";
+}
+
+/**
+ * @brief finds a resident graph, loading it first if it is not resident yet
+ * @note on success, the graph is returned locked, so that no other request can use it until the lock is released
+ * @param path path to the graph (used as its name)
+ * @param lock lock that will hold the mutex of the graph
+ * @param load where the time it took to load the graph will be stored (0 if it was already resident)
+ * @param status where the reason of the failure will be stored
+ * @return the resident graph, or nullptr if it could not be loaded
+ */
+std::shared_ptr<Server::Resident> Server::acquire(const string &path, std::unique_lock<std::mutex> &lock,
+                                                  long long &load, string &status) {
+    std::shared_ptr<Resident> resident;
+
+    {
+        std::lock_guard<std::mutex> graphsLock(graphsMutex);
+        std::shared_ptr<Resident> &entry = graphs[path];
+
+        if (!entry) entry = std::make_shared<Resident>();
+        resident = entry;
+    }
+
+    lock = std::unique_lock<std::mutex>(resident->mutex);
+    load = 0;
+
+    if (resident->loaded) return resident;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    bool loaded = false;
+
+    if (access(path.c_str(), 0) == -1) status = "missing_graph";
+    else {
+        try {
+            resident->graph = Reader().read(path, detectHeader ? Reader::detectHeader(path) : hasHeader);
+            loaded = true;
+        }
+        catch (const std::exception &) {
+            status = "invalid_graph";
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    load = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    if (loaded) {
+        resident->vertices = resident->graph.countVertices();
+        resident->edges = resident->graph.countEdges();
+        resident->loaded = true;
+
+        return resident;
+    }
+
+    // forget the graph, unless another request has already replaced it
+    lock.unlock();
+    std::lock_guard<std::mutex> graphsLock(graphsMutex);
+
+    auto it = graphs.find(path);
+    if (it != graphs.end() && it->second == resident) graphs.erase(it);
+
+    return nullptr;
+}
+
+/**
+ * @brief handles a "load <graph>" request
+ * @param request rest of the request
+ * @return JSON object with the size of the graph and the time it took to load it
+ */
+string Server::load(std::istringstream &request) {
+    string path;
+    if (!(request >> path)) return error("missing graph");
+
+    std::unique_lock<std::mutex> lock;
+    long long loadTime;
+    string status;
+
+    std::shared_ptr<Resident> resident = acquire(path, lock, loadTime, status);
+    if (!resident) return error(status);
+
+    return "{\"graph\":" + ResultWriter::quote(path, ResultWriter::JSON) + ",\"vertices\":" +
+           std::to_string(resident->vertices) + ",\"edges\":" + std::to_string(resident->edges) + ",\"load_ms\":" +
+           std::to_string(loadTime) + "}\n";
+}
+
+/**
+ * @brief handles a "solve <graph> <algorithm> [source] [time limit]" request, running the algorithm on the thread of
+ * the connection while the graph is locked (so that requests for different graphs are served concurrently, and only
+ * the parallel parts of the algorithms go to the shared ThreadPool, where a solve can never run nested in another)
+ * @note at most one solve per worker of the shared ThreadPool runs at once (the other ones wait for their turn, with
+ * their graphs locked), so that the number of connections does not oversubscribe the CPUs
+ * @param request rest of the request
+ * @return JSON object with the result (as written by the ResultWriter, including the tour)
+ */
+string Server::solve(std::istringstream &request) {
+    string path, algorithm;
+    if (!(request >> path >> algorithm)) return error("missing graph or algorithm");
+    if (!TSPGraph::isAlgorithm(algorithm)) return error("unknown algorithm");
+
+    int src = 0;
+    double timeLimit = 0;
+    string extra;
+
+    if ((request >> extra && !Utils::toInt(extra, src, 0))
+        || (request >> extra && !Utils::toDouble(extra, timeLimit, 0)))
+        return error("invalid source or time limit");
+
+    std::unique_lock<std::mutex> lock;
+    long long loadTime;
+    string status;
+
+    std::shared_ptr<Resident> resident = acquire(path, lock, loadTime, status);
+    if (!resident) return error(status);
+
+    if (src < 0 || src >= resident->vertices) return error("invalid source");
+
+    // however many connections are open, only one solve per worker of the shared ThreadPool runs at once
+    std::unique_lock<std::mutex> solvingLock(solvingMutex);
+    solved.wait(solvingLock, [this]() { return solving < ThreadPool::shared().size(); });
+    ++solving;
+    solvingLock.unlock();
+
+    Progress progress;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    Tour tour = resident->graph.solve(algorithm, src + 1, timeLimit, progress,
+                                      cache ? &SolutionCache::shared() : nullptr);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    solvingLock.lock();
+    --solving;
+    solvingLock.unlock();
+    solved.notify_one();
+
+    long long time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    string response;
+    ResultWriter writer(response, ResultWriter::JSON, true);
+
+    writer.write({path, algorithm, progress.isCancelled() ? "timeout" : "ok", src, resident->vertices,
+                  tour.hasDistances() ? tour.getLength() : 0, progress.snapshot().bound, time, loadTime,
+                  tour.hasDistances() ? &tour : nullptr, nullptr});
+    writer.flush();
+
+    // once the run is over, so that writing the cache file is not counted as part of it
+    resident->graph.persistMatrix();
+
+    return response;
+}
+
+/**
+ * @brief handles an "unload <graph>" request (the requests that are using the graph still finish normally)
+ * @param request rest of the request
+ * @return JSON object indicating if the graph was resident
+ */
+string Server::unload(std::istringstream &request) {
+    string path;
+    if (!(request >> path)) return error("missing graph");
+
+    std::lock_guard<std::mutex> graphsLock(graphsMutex);
+    bool resident = graphs.erase(path) > 0;
+
+    return "{\"graph\":" + ResultWriter::quote(path, ResultWriter::JSON) + ",\"unloaded\":" +
+           (resident ? "true" : "false") + "}\n";
+}
+
+/**
+ * @brief handles a "list" request
+ * @return JSON object with the resident graphs (the ones that are still being loaded are not listed)
+ */
+string Server::list() {
+    std::vector<std::shared_ptr<Resident>> residents;
+    std::vector<string> paths;
+
+    {
+        std::lock_guard<std::mutex> graphsLock(graphsMutex);
+
+        for (const auto &entry : graphs) {
+            paths.push_back(entry.first);
+            residents.push_back(entry.second);
+        }
+    }
+
+    string res = "{\"graphs\":[";
+    bool first = true;
+
+    for (size_t i = 0; i < residents.size(); ++i) {
+        // the size is published before the flag, so a graph that is loaded always has it (even if a solve holds it)
+        if (!residents[i]->loaded) continue;
+
+        if (!first) res += ',';
+        first = false;
+
+        res += "{\"graph\":" + ResultWriter::quote(paths[i], ResultWriter::JSON) + ",\"vertices\":" +
+               std::to_string(residents[i]->vertices) + "}";
+    }
+
+    return res + "]}\n";
+}
+
+/**
+ * @brief handles a request
+ * @param request text of the request
+ * @return text of the response
+ */
+string Server::handle(const string &request) {
+    std::istringstream request_(request);
+
+    string command;
+    request_ >> command;
+
+    if (command == "load") return load(request_);
+    if (command == "solve") return solve(request_);
+    if (command == "unload") return unload(request_);
+    if (command == "list") return list();
+
+    if (command == "shutdown") {
+        stop();
+        return "{\"shutdown\":true}\n";
+    }
+
+    return error("unknown request");
+}
+
+/**
+ * @brief serves the requests of a connection, one at a time, until it is closed
+ * @param fd socket of the connection
+ */
+void Server::serve(int fd) {
+    string request;
+
+    while (!stopping && readMessage(fd, request)) {
+        if (!writeMessage(fd, handle(request))) break;
+    }
+
+    close(fd);
+
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    clients.erase(fd);
+    idle.notify_all();
+}
+
+/**
+ * @brief stops accepting connections and closes the ones that are waiting for a request
+ */
+void Server::stop() {
+    stopping = true;
+    shutdown(listener, SHUT_RDWR);
+
+    std::lock_guard<std::mutex> lock(clientsMutex);
+
+    for (int fd : clients)
+        shutdown(fd, SHUT_RD);
+}
+
+/**
+ * @brief parses the command-line arguments of the server
+ * @param argc number of arguments
+ * @param argv arguments (the first one being the name of the program)
+ * @return 'true' if the arguments are valid, 'false' otherwise
+ */
+bool Server::parse(int argc, char *argv[]) {
+    int threads = 0;
+    bool pinning = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = (i + 1 < argc), valid = true;
+
+        if (arg == "--serve" && hasValue) socketPath = argv[++i];
+        else if (arg == "--header" || arg == "--no-header") {
+            detectHeader = false;
+            hasHeader = (arg == "--header");
+        }
+        else if (arg == "--no-cache") cache = false;
+        else if (arg == "--matrix-cache" && hasValue) Reader::setMatrixCache(argv[++i]);
+        else if (arg == "--threads" && hasValue) valid = Utils::toInt(argv[++i], threads, 0);
+        else if (arg == "--pin") pinning = true;
+        else {
+            cerr << "Invalid option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+
+        if (!valid) {
+            cerr << "Invalid value '" << argv[i] << "' for the option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+    }
+
+    ThreadPool::configure(threads, pinning);
+
+    if (socketPath.empty()) usage(cerr);
+    return !socketPath.empty();
+}
+
+/**
+ * @brief listens on the socket, serving each connection on its own thread (which also runs the algorithms, leaving
+ * only their parallel parts to the shared ThreadPool, and as many at once as the ThreadPool has workers), until a
+ * shutdown request is received
+ * @return exit status of the program
+ */
+int Server::run() {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cerr << "The socket path is too long." << endl;
+        return 1;
+    }
+
+    strcpy(address.sun_path, socketPath.c_str());
+    unlink(socketPath.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (listener == -1 || bind(listener, (sockaddr *) &address, sizeof(address)) == -1 || listen(listener, 64) == -1) {
+        cerr << "Could not listen on '" << socketPath << "': " << strerror(errno) << endl;
+        return 1;
+    }
+
+    cerr << "Listening on " << socketPath << endl;
+
+    while (!stopping) {
+        int fd = accept(listener, nullptr, nullptr);
+
+        if (fd == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(clientsMutex);
+
+        if (stopping) {
+            close(fd);
+            break;
+        }
+
+        clients.insert(fd);
+        std::thread(&Server::serve, this, fd).detach();
+    }
+
+    // wait for the connections to finish their current requests
+    std::unique_lock<std::mutex> lock(clientsMutex);
+    idle.wait(lock, [this]() { return clients.empty(); });
+
+    close(listener);
+    unlink(socketPath.c_str());
+
+    return 0;
+}
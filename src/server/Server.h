@@ -0,0 +1,71 @@
+#ifndef DA_PROJ2_SERVER_H
+#define DA_PROJ2_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "../network/TSPGraph.h"
+
+using std::string;
+
+class Server {
+/* ATTRIBUTES */
+private:
+    struct Resident {
+        TSPGraph graph;
+        std::mutex mutex;       // held while the graph is loaded or solved, as the algorithms modify it
+        std::atomic<bool> loaded{false};        // set once the size is known, which never changes afterwards
+        std::atomic<int> vertices{0}, edges{0}; // so that 'list' can read them without waiting for a solve
+    };
+
+    string socketPath;
+    bool detectHeader, hasHeader, cache;   // hasHeader is only used if the header is not detected
+
+    int listener;
+    std::atomic<bool> stopping;
+
+    std::map<string, std::shared_ptr<Resident>> graphs;
+    std::mutex graphsMutex;
+
+    std::set<int> clients;      // sockets of the open connections, each served by its own thread
+    std::mutex clientsMutex;
+    std::condition_variable idle;
+
+    int solving;                // number of solves that are running (at most one per worker of the shared ThreadPool)
+    std::mutex solvingMutex;
+    std::condition_variable solved;
+
+/* CONSTRUCTOR */
+public:
+    Server();
+
+/* METHODS */
+private:
+    static void usage(std::ostream &out);
+    static bool readMessage(int fd, string &message);
+    static bool writeMessage(int fd, const string &message);
+    static string error(const string &message);
+
+    std::shared_ptr<Resident> acquire(const string &path, std::unique_lock<std::mutex> &lock, long long &load,
+                                      string &status);
+    string load(std::istringstream &request);
+    string solve(std::istringstream &request);
+    string unload(std::istringstream &request);
+    string list();
+    string handle(const string &request);
+
+    void serve(int fd);
+    void stop();
+
+public:
+    bool parse(int argc, char *argv[]);
+    int run();
+};
+
+#endif //DA_PROJ2_SERVER_H
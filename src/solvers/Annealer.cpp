@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Annealer.h"
+
+/**
+ * @brief creates a new Annealer, which performs Metropolis steps over the 2-opt and Or-opt neighbourhoods of a tour
+ * @param matrix fully populated distance matrix
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ * @param seed seed of the random number generator (0 picks a random one)
+ */
+Annealer::Annealer(const DistanceMatrix &matrix, std::vector<int> order, uint64_t seed)
+    : matrix(&matrix), rng(seed), order(std::move(order)) {
+    length = tourLength();
+
+    bestOrder = this->order;
+    bestLength = length;
+}
+
+/**
+ * @brief returns the distance between the vertices at two positions of the tour
+ * @param i position of the first vertex
+ * @param j position of the second vertex
+ * @return distance between the two vertices
+ */
+double Annealer::d(int i, int j) const {
+    return (*matrix)(order[i], order[j]);
+}
+
+/**
+ * @brief computes the length of the current tour from scratch
+ * @complexity O(|V|)
+ * @return length of the current tour
+ */
+double Annealer::tourLength() const {
+    double sum = 0;
+
+    for (int i = 0; i < (int) order.size(); ++i)
+        sum += d(i, (i + 1) % (int) order.size());
+
+    return sum;
+}
+
+/**
+ * @brief reverses the (cyclic) range of positions [i, j] of the tour, or its complement if it is shorter
+ * @complexity O(|V|)
+ * @param i first position of the range
+ * @param j last position of the range
+ */
+void Annealer::reverse(int i, int j) {
+    int n = (int) order.size();
+
+    int size = j - i;
+    if (size < 0) size += n;
+    ++size;
+
+    if (2 * size > n) {
+        std::swap(i, j);
+        i = (i + 1) % n;
+        j = (j - 1 + n) % n;
+
+        size = n - size;
+    }
+
+    for (int k = 0; k < size / 2; ++k) {
+        std::swap(order[i], order[j]);
+
+        if (++i == n) i = 0;
+        if (--j < 0) j = n - 1;
+    }
+}
+
+/**
+ * @brief attempts a random 2-opt move, which reverses a section of the tour
+ * @complexity O(1) to evaluate, O(|V|) to apply
+ * @param temperature current temperature
+ * @return 'true' if the move was accepted, 'false' otherwise
+ */
+bool Annealer::twoOptMove(double temperature) {
+    int n = (int) order.size();
+
+    int i = rng.nextInt(n), j = rng.nextInt(n);
+    if (i > j) std::swap(i, j);
+    if (j - i < 1 || (i == 0 && j == n - 1)) return false;
+
+    int prev = (i - 1 + n) % n, next = (j + 1) % n;
+
+    // never add a missing edge, while removing one is always accepted (and the length is then recomputed, as an
+    // incremental update would be swallowed by INF)
+    double added = d(prev, j) + d(i, next), removed = d(prev, i) + d(j, next);
+    if (DistanceMatrix::isMissing(d(prev, j)) || DistanceMatrix::isMissing(d(i, next))) return false;
+
+    bool exact = DistanceMatrix::isMissing(d(prev, i)) || DistanceMatrix::isMissing(d(j, next));
+    double delta = added - removed;
+
+    if (!exact && delta > 0 && rng.nextDouble() >= std::exp(-delta / temperature))
+        return false;
+
+    reverse(i, j);
+    length = exact ? tourLength() : length + delta;
+
+    return true;
+}
+
+/**
+ * @brief attempts a random Or-opt move, which moves a section of up to three vertices (possibly reversing it) to
+ * another place of the tour
+ * @complexity O(1) to evaluate, O(|V|) to apply
+ * @param temperature current temperature
+ * @return 'true' if the move was accepted, 'false' otherwise
+ */
+bool Annealer::orOptMove(double temperature) {
+    int n = (int) order.size();
+
+    int size = 1 + rng.nextInt(3);
+    int i = rng.nextInt(n - size + 1), j = i + size - 1; // section [i, j]
+    int p = rng.nextInt(n);                               // the section will be placed after position p
+
+    int prev = (i - 1 + n) % n, next = (j + 1) % n;
+    if (p == prev || (p >= i && p <= j)) return false;
+
+    int after = (p + 1) % n;
+    bool reversed = rng.nextInt(2);
+
+    // as in the 2-opt move, missing edges are never added and removing them forces the length to be recomputed
+    double bridge = d(prev, next), left = reversed ? d(p, j) : d(p, i), right = reversed ? d(i, after) : d(j, after);
+    if (DistanceMatrix::isMissing(bridge) || DistanceMatrix::isMissing(left) || DistanceMatrix::isMissing(right))
+        return false;
+
+    bool exact = DistanceMatrix::isMissing(d(prev, i)) || DistanceMatrix::isMissing(d(j, next))
+                 || DistanceMatrix::isMissing(d(p, after));
+
+    double delta = (bridge + left + right) - (d(prev, i) + d(j, next) + d(p, after));
+
+    if (!exact && delta > 0 && rng.nextDouble() >= std::exp(-delta / temperature))
+        return false;
+
+    auto first = order.begin() + i, last = order.begin() + j + 1;
+
+    if (p > j) {
+        std::rotate(first, last, order.begin() + p + 1);
+        first = order.begin() + p + 1 - size;
+    }
+    else {
+        std::rotate(order.begin() + p + 1, first, last);
+        first = order.begin() + p + 1;
+    }
+
+    if (reversed) std::reverse(first, first + size);
+    length = exact ? tourLength() : length + delta;
+
+    return true;
+}
+
+/**
+ * @brief performs a Metropolis step, i.e. attempts a random 2-opt or Or-opt move, accepting it if it shortens the
+ * tour or, otherwise, with probability exp(-delta / temperature)
+ * @param temperature current temperature
+ * @return 'true' if the move was accepted, 'false' otherwise
+ */
+bool Annealer::step(double temperature) {
+    if (order.size() < 5) return false;
+
+    bool accepted = (rng.next() & 1) ? twoOptMove(temperature) : orOptMove(temperature);
+
+    // the incremental length drifts over many moves, so it is made exact before it becomes the best one
+    if (accepted && length < bestLength - 1e-9) {
+        length = tourLength();
+
+        if (length < bestLength - 1e-9) {
+            bestOrder = order;
+            bestLength = length;
+        }
+    }
+
+    return accepted;
+}
+
+/**
+ * @brief estimates the temperature at which a given fraction of the worsening moves would be accepted
+ * @param samples number of random 2-opt moves to sample
+ * @param acceptance fraction of worsening moves that should be accepted
+ * @return estimated temperature
+ */
+double Annealer::sampleTemperature(int samples, double acceptance) {
+    int n = (int) order.size();
+    if (n < 5) return 1;
+
+    double total = 0;
+    int count = 0;
+
+    for (int k = 0; k < samples; ++k) {
+        int i = rng.nextInt(n), j = rng.nextInt(n);
+        if (i > j) std::swap(i, j);
+        if (j - i < 1 || (i == 0 && j == n - 1)) continue;
+
+        int prev = (i - 1 + n) % n, next = (j + 1) % n;
+        double edges[] = {d(prev, j), d(i, next), d(prev, i), d(j, next)};
+
+        // a missing edge would make the temperature (and, with it, the acceptance of any move) absurdly high
+        if (std::any_of(edges, edges + 4, DistanceMatrix::isMissing)) continue;
+
+        double delta = edges[0] + edges[1] - edges[2] - edges[3];
+        if (delta <= 0) continue;
+
+        total += delta;
+        ++count;
+    }
+
+    return count ? -(total / count) / std::log(acceptance) : 1;
+}
+
+/**
+ * @brief exchanges the current tours (but not the best tours) of two Annealers
+ * @param other Annealer whose current tour will be exchanged
+ */
+void Annealer::swap(Annealer &other) {
+    std::swap(order, other.order);
+    std::swap(length, other.length);
+}
+
+/**
+ * @brief returns the length of the current tour
+ * @return length of the current tour
+ */
+double Annealer::getLength() const {
+    return length;
+}
+
+/**
+ * @brief returns the length of the best tour found so far
+ * @return length of the best tour
+ */
+double Annealer::getBestLength() const {
+    return bestLength;
+}
+
+/**
+ * @brief returns the best tour found so far
+ * @return std::vector containing the indices of the vertices in the order they are visited
+ */
+const std::vector<int> &Annealer::getBestOrder() const {
+    return bestOrder;
+}
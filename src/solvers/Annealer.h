@@ -0,0 +1,44 @@
+#ifndef DA_PROJ2_ANNEALER_H
+#define DA_PROJ2_ANNEALER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../network/DistanceMatrix.h"
+#include "../utils/Random.hpp"
+
+class Annealer {
+/* ATTRIBUTES */
+private:
+    const DistanceMatrix *matrix;
+    XorShift rng;
+
+    std::vector<int> order; // vertices in the order they are visited
+    double length;
+
+    std::vector<int> bestOrder;
+    double bestLength;
+
+/* CONSTRUCTOR */
+public:
+    Annealer(const DistanceMatrix &matrix, std::vector<int> order, uint64_t seed = 0);
+
+/* METHODS */
+private:
+    double d(int i, int j) const;
+    double tourLength() const;
+    void reverse(int i, int j);
+    bool twoOptMove(double temperature);
+    bool orOptMove(double temperature);
+
+public:
+    bool step(double temperature);
+    double sampleTemperature(int samples, double acceptance);
+    void swap(Annealer &other);
+
+    double getLength() const;
+    double getBestLength() const;
+    const std::vector<int> &getBestOrder() const;
+};
+
+#endif //DA_PROJ2_ANNEALER_H
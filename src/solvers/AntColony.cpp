@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "AntColony.h"
+#include "Candidates.h"
+#include "LocalSearch.h"
+#include "../parallel/ThreadPool.h"
+#include "../utils/Tracer.h"
+
+/**
+ * @brief creates a new AntColony solver, based on the MAX-MIN Ant System
+ * @param matrix fully populated distance matrix (shared, read-only, by every ant)
+ * @param config number of ants, weights, evaporation rate and time budget
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ */
+AntColony::AntColony(const DistanceMatrix &matrix, const Config &config, Progress *progress)
+    : matrix(matrix), config(config), progress(progress), size(matrix.dimension()),
+      candidates(Candidates::nearest(matrix, config.candidates)), pheromone((size_t) size * size),
+      heuristic((size_t) size * size), choice((size_t) size * size), minPheromone(0), maxPheromone(1) {
+    for (int i = 1; i < size; ++i) {
+        for (int j = 1; j < size; ++j) {
+            double d = matrix(i, j);
+            heuristic[(size_t) i * size + j] = (i == j) ? 0 : (float) std::pow(1 / std::max(d, 1e-9), config.beta);
+        }
+    }
+}
+
+/**
+ * @brief computes the length of a tour
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ * @return length of the tour
+ */
+double AntColony::length(const std::vector<int> &order) const {
+    double res = 0;
+
+    for (size_t i = 0; i < order.size(); ++i)
+        res += matrix(order[i], order[(i + 1) % order.size()]);
+
+    return res;
+}
+
+/**
+ * @brief builds the tour of an ant, which moves to one of the unvisited candidates of its current vertex with
+ * probability proportional to pheromone^alpha * heuristic or, if they were all visited, to the best unvisited vertex
+ * @complexity O(|V| * k) (O(|V|^2) in the worst case)
+ * @param start index of the vertex where the ant starts
+ * @param order std::vector where the tour will be stored
+ * @param visited buffer (with one entry per vertex) used to mark the visited vertices
+ * @param rng random number generator of the ant
+ */
+void AntColony::construct(int start, std::vector<int> &order, std::vector<char> &visited, XorShift &rng) const {
+    int n = size - 1;
+
+    order.clear();
+    std::fill(visited.begin(), visited.end(), false);
+
+    int curr = start;
+    order.push_back(curr);
+    visited[curr] = true;
+
+    while ((int) order.size() < n) {
+        const float *row = &choice[(size_t) curr * size];
+        int next = -1;
+
+        // roulette wheel over the unvisited candidates
+        double total = 0;
+        for (int c : candidates[curr])
+            if (!visited[c]) total += row[c];
+
+        if (total > 0) {
+            double r = rng.nextDouble() * total;
+
+            for (int c : candidates[curr]) {
+                if (visited[c]) continue;
+
+                next = c;
+                if ((r -= row[c]) <= 0) break;
+            }
+        }
+        else {
+            float best = -1;
+
+            for (int v = 1; v <= n; ++v) {
+                if (visited[v] || row[v] <= best) continue;
+
+                best = row[v];
+                next = v;
+            }
+        }
+
+        order.push_back(next);
+        visited[next] = true;
+        curr = next;
+    }
+}
+
+/**
+ * @brief updates the bounds of the pheromone trails, according to the length of the best tour
+ * @param bestLength length of the best tour found so far
+ */
+void AntColony::setBounds(double bestLength) {
+    maxPheromone = (float) (1 / (config.evaporation * bestLength));
+    minPheromone = maxPheromone / (float) (2 * (size - 1));
+}
+
+/**
+ * @brief evaporates the pheromone of every edge, without letting it fall below the lower bound, and scales the
+ * attractiveness of every edge accordingly (as (tau * keep)^alpha = tau^alpha * keep^alpha, only the two constants are
+ * raised to alpha)
+ * @note the loop runs over flat arrays, with no branches or calls to std::pow, so that the compiler vectorizes it
+ * @complexity O(|V|^2)
+ */
+void AntColony::evaporate() {
+    const float keep = (float) (1 - config.evaporation), low = minPheromone;
+    const float keepWeight = (float) std::pow(keep, config.alpha), lowWeight = (float) std::pow(low, config.alpha);
+
+    float *tau = pheromone.data(), *res = choice.data();
+    const float *eta = heuristic.data();
+
+    for (size_t i = 0, n = pheromone.size(); i < n; ++i) {
+        tau[i] = std::max(tau[i] * keep, low);
+        res[i] = std::max(res[i] * keepWeight, lowWeight * eta[i]);
+    }
+}
+
+/**
+ * @brief deposits pheromone on the edges of a tour, without letting it rise above the upper bound, and recomputes the
+ * attractiveness of those edges
+ * @note nothing is deposited on a tour that uses a missing edge (whose length is INF), as it is not a valid tour
+ * @complexity O(|V|)
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ * @param length length of the tour
+ */
+void AntColony::deposit(const std::vector<int> &order, double length) {
+    if (std::isnan(length) || DistanceMatrix::isMissing(length)) return;
+
+    float amount = (float) (1 / length);
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        int u = order[i], v = order[(i + 1) % order.size()];
+
+        float &uv = pheromone[(size_t) u * size + v], &vu = pheromone[(size_t) v * size + u];
+        uv = vu = std::min(uv + amount, maxPheromone);
+
+        float weight = (config.alpha == 1) ? uv : (float) std::pow(uv, config.alpha);
+        choice[(size_t) u * size + v] = choice[(size_t) v * size + u] = weight * heuristic[(size_t) u * size + v];
+    }
+}
+
+/**
+ * @brief computes the attractiveness (pheromone^alpha * heuristic) of every edge
+ * @note only called once, as evaporate() and deposit() keep the attractiveness up to date from then on
+ * @complexity O(|V|^2)
+ */
+void AntColony::updateChoices() {
+    const float *tau = pheromone.data(), *eta = heuristic.data();
+    float *res = choice.data();
+    size_t n = choice.size();
+
+    if (config.alpha == 1) {
+        for (size_t i = 0; i < n; ++i)
+            res[i] = tau[i] * eta[i];
+    }
+    else {
+        float alpha = (float) config.alpha;
+
+        for (size_t i = 0; i < n; ++i)
+            res[i] = std::pow(tau[i], alpha) * eta[i];
+    }
+}
+
+/**
+ * @brief improves a tour using ant colony optimization, in which the ants of each iteration build their tours in
+ * parallel and only the best tour (of the iteration or, every few iterations, of the whole run) deposits pheromone
+ * @param order std::vector containing the initial tour, where the best tour found will be stored
+ * @return length of the best tour found
+ */
+double AntColony::run(std::vector<int> &order) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(config.timeLimit));
+
+    ThreadPool &pool = ThreadPool::shared();
+
+    int threadCount = config.threads ? config.threads : pool.size();
+    threadCount = std::max(1, std::min(threadCount, config.ants));
+
+    std::vector<int> best = order;
+    double bestLength = length(order);
+
+    // the bounds are kept at their defaults until a tour that does not use a missing edge is found
+    if (!DistanceMatrix::isMissing(bestLength)) setBounds(bestLength);
+    Progress::improve(progress, bestLength);
+    std::fill(pheromone.begin(), pheromone.end(), maxPheromone);
+    updateChoices();
+
+    XorShift rng(config.seed);
+    std::vector<XorShift> rngs;
+
+    for (int t = 0; t < threadCount; ++t)
+        rngs.emplace_back(rng.next());
+
+    std::vector<std::vector<int>> tours(config.ants);
+    std::vector<double> lengths(config.ants);
+
+    for (int it = 0; !config.iterations || it < config.iterations; ++it) {
+        if (std::chrono::steady_clock::now() >= deadline || Progress::isCancelled(progress)) break;
+
+        // let the ants build their tours, in parallel
+        pool.parallelFor(threadCount, [this, threadCount, &tours, &lengths, &rngs](int t) {
+            TRACE_SCOPE("construct tours", t);
+
+            std::vector<char> visited(size);
+            LocalSearch search(matrix, candidates);
+
+            for (int a = t; a < config.ants; a += threadCount) {
+                construct(1 + rngs[t].nextInt(size - 1), tours[a], visited, rngs[t]);
+
+                if (config.localSearch) {
+                    ArrayTour tour(tours[a]);
+
+                    search.activateAll();
+                    lengths[a] = search.twoOpt(tour, search.length(tour));
+
+                    tours[a] = tour.toVector(tour.at(0));
+                }
+                else lengths[a] = length(tours[a]);
+            }
+        });
+
+        int iterationBest = (int) (std::min_element(lengths.begin(), lengths.end()) - lengths.begin());
+
+        if (lengths[iterationBest] < bestLength - 1e-9) {
+            best = tours[iterationBest];
+            bestLength = lengths[iterationBest];
+
+            if (!DistanceMatrix::isMissing(bestLength)) setBounds(bestLength);
+            Progress::improve(progress, bestLength);
+        }
+
+        // update the pheromone
+        {
+            TRACE_SCOPE("update pheromone");
+            evaporate();
+
+            if (it % 5 == 4) deposit(best, bestLength);
+            else deposit(tours[iterationBest], lengths[iterationBest]);
+        }
+        Progress::advance(progress, 1);
+    }
+
+    order = best;
+    return bestLength;
+}
@@ -0,0 +1,56 @@
+#ifndef DA_PROJ2_ANTCOLONY_H
+#define DA_PROJ2_ANTCOLONY_H
+
+#include <vector>
+
+#include "Budget.h"
+#include "../network/DistanceMatrix.h"
+#include "../utils/Progress.h"
+#include "../utils/Random.hpp"
+
+class AntColony {
+/* ATTRIBUTES */
+public:
+    struct Config : Budget {
+        int ants = 20;              // ants per iteration
+        double alpha = 1;           // weight of the pheromone
+        double beta = 3;            // weight of the heuristic information (inverse of the distance)
+        double evaporation = 0.1;   // fraction of the pheromone that evaporates after each iteration
+        int candidates = 15;        // size of the candidate list of each vertex
+        bool localSearch = true;    // indicates if the tour of each ant should be optimized with 2-opt
+        int iterations = 0;         // 0 runs until the time budget runs out
+        int threads = 0;            // number of parallel tasks (0 uses one per worker of the shared ThreadPool)
+
+        Config() : Budget(10) {}
+    };
+
+private:
+    const DistanceMatrix &matrix;
+    Config config;
+    Progress *progress;
+    int size;                       // number of rows (and columns) of the flat matrices
+
+    std::vector<std::vector<int>> candidates;
+    std::vector<float> pheromone;   // flat |V| x |V| matrix
+    std::vector<float> heuristic;   // inverse of the distance, raised to beta
+    std::vector<float> choice;      // pheromone^alpha * heuristic
+    float minPheromone, maxPheromone;
+
+/* CONSTRUCTOR */
+public:
+    AntColony(const DistanceMatrix &matrix, const Config &config, Progress *progress = nullptr);
+
+/* METHODS */
+private:
+    double length(const std::vector<int> &order) const;
+    void construct(int start, std::vector<int> &order, std::vector<char> &visited, XorShift &rng) const;
+    void setBounds(double bestLength);
+    void evaporate();
+    void deposit(const std::vector<int> &order, double length);
+    void updateChoices();
+
+public:
+    double run(std::vector<int> &order);
+};
+
+#endif //DA_PROJ2_ANTCOLONY_H
@@ -0,0 +1,17 @@
+#ifndef DA_PROJ2_BUDGET_H
+#define DA_PROJ2_BUDGET_H
+
+#include <cstdint>
+
+/*
+ * settings shared by the metaheuristics, which improve a tour until their time budget runs out (each of them extends
+ * it with its own Config, which sets its default time limit)
+ */
+struct Budget {
+    double timeLimit;           // in seconds
+    uint64_t seed = 0;          // 0 picks a random seed
+
+    explicit Budget(double timeLimit) : timeLimit(timeLimit) {}
+};
+
+#endif //DA_PROJ2_BUDGET_H
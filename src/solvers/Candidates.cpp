@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+#include "Candidates.h"
+
+/**
+ * @brief computes the candidate list of each vertex, i.e. its k nearest neighbours, sorted by distance
+ * @complexity O(|V|^2 * log(k))
+ * @param matrix fully populated distance matrix
+ * @param k number of candidates of each vertex
+ * @return std::vector containing the candidates of each vertex
+ */
+std::vector<std::vector<int>> Candidates::nearest(const DistanceMatrix &matrix, int k) {
+    int n = matrix.dimension() - 1;
+    k = std::min(k, n - 1);
+
+    std::vector<std::vector<int>> candidates(n + 1);
+    if (k <= 0) return candidates;
+
+    std::vector<int> others;
+    others.reserve(n);
+
+    for (int v = 1; v <= n; ++v) {
+        others.clear();
+
+        for (int u = 1; u <= n; ++u)
+            if (u != v) others.push_back(u);
+
+        std::partial_sort(others.begin(), others.begin() + k, others.end(), [&matrix, v](int a, int b) {
+            return matrix(v, a) < matrix(v, b);
+        });
+
+        candidates[v].assign(others.begin(), others.begin() + k);
+    }
+
+    return candidates;
+}
+
+/**
+ * @brief computes the candidate list of each vertex from points of the plane, i.e. its k nearest neighbours by
+ * euclidean distance, sorted by that distance, without a distance matrix (the points are bucketed into a grid of about
+ * two points per cell, whose rings are searched outwards from each point until no closer point can be left)
+ * @complexity O(|V| * k * log(k)) for points that are spread evenly
+ * @param x x-coordinate of each vertex (starting at index 1)
+ * @param y y-coordinate of each vertex (starting at index 1)
+ * @param k number of candidates of each vertex
+ * @return std::vector containing the candidates of each vertex
+ */
+std::vector<std::vector<int>> Candidates::nearest(const std::vector<double> &x, const std::vector<double> &y, int k) {
+    int n = (int) x.size() - 1;
+    k = std::min(k, n - 1);
+
+    std::vector<std::vector<int>> candidates(n + 1);
+    if (k <= 0) return candidates;
+
+    double minX = *std::min_element(x.begin() + 1, x.end()), maxX = *std::max_element(x.begin() + 1, x.end());
+    double minY = *std::min_element(y.begin() + 1, y.end()), maxY = *std::max_element(y.begin() + 1, y.end());
+
+    int side = std::max(1, (int) std::sqrt(n / 2.0));
+    double cell = std::max(maxX - minX, maxY - minY) / side;
+    if (cell <= 0) cell = 1;
+
+    int width = (int) ((maxX - minX) / cell) + 1, height = (int) ((maxY - minY) / cell) + 1;
+
+    auto cellOf = [&](int v) {
+        int i = std::min(width - 1, (int) ((x[v] - minX) / cell));
+        int j = std::min(height - 1, (int) ((y[v] - minY) / cell));
+
+        return std::make_pair(i, j);
+    };
+
+    // bucket the points by cell, in a compressed layout (the points of cell c are in [start[c], start[c + 1][)
+    std::vector<int> start((size_t) width * height + 1, 0), points(n);
+
+    for (int v = 1; v <= n; ++v) {
+        auto c = cellOf(v);
+        ++start[(size_t) c.second * width + c.first + 1];
+    }
+
+    for (size_t c = 1; c < start.size(); ++c)
+        start[c] += start[c - 1];
+
+    std::vector<int> fill(start.begin(), start.end() - 1);
+
+    for (int v = 1; v <= n; ++v) {
+        auto c = cellOf(v);
+        points[fill[(size_t) c.second * width + c.first]++] = v;
+    }
+
+    // the k nearest points found so far, with the farthest one on top
+    std::priority_queue<std::pair<double, int>> nearest;
+
+    for (int v = 1; v <= n; ++v) {
+        auto c = cellOf(v);
+
+        for (int ring = 0; ring <= std::max(width, height); ++ring) {
+            // the points that are left are at least ring - 1 cells away
+            double reach = (ring - 1) * cell;
+            if ((int) nearest.size() == k && ring > 0 && reach * reach >= nearest.top().first) break;
+
+            for (int j = c.second - ring; j <= c.second + ring; ++j) {
+                if (j < 0 || j >= height) continue;
+
+                // inside the ring, only its first and last columns are visited
+                int step = (j == c.second - ring || j == c.second + ring) ? 1 : std::max(1, 2 * ring);
+
+                for (int i = c.first - ring; i <= c.first + ring; i += step) {
+                    if (i < 0 || i >= width) continue;
+
+                    size_t index = (size_t) j * width + i;
+
+                    for (int p = start[index]; p < start[index + 1]; ++p) {
+                        int u = points[p];
+                        if (u == v) continue;
+
+                        double d = (x[u] - x[v]) * (x[u] - x[v]) + (y[u] - y[v]) * (y[u] - y[v]);
+
+                        if ((int) nearest.size() < k) nearest.emplace(d, u);
+                        else if (d < nearest.top().first) {
+                            nearest.pop();
+                            nearest.emplace(d, u);
+                        }
+                    }
+                }
+            }
+        }
+
+        candidates[v].resize(nearest.size());
+
+        for (size_t i = nearest.size(); i > 0; --i) {
+            candidates[v][i - 1] = nearest.top().second;
+            nearest.pop();
+        }
+    }
+
+    return candidates;
+}
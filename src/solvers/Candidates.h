@@ -0,0 +1,14 @@
+#ifndef DA_PROJ2_CANDIDATES_H
+#define DA_PROJ2_CANDIDATES_H
+
+#include <vector>
+
+#include "../network/DistanceMatrix.h"
+
+class Candidates {
+public:
+    static std::vector<std::vector<int>> nearest(const DistanceMatrix &matrix, int k);
+    static std::vector<std::vector<int>> nearest(const std::vector<double> &x, const std::vector<double> &y, int k);
+};
+
+#endif //DA_PROJ2_CANDIDATES_H
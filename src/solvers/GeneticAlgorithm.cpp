@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "Candidates.h"
+#include "GeneticAlgorithm.h"
+#include "HeldKarp.h"
+#include "LocalSearch.h"
+#include "../parallel/ThreadPool.h"
+#include "../utils/Tracer.h"
+#include "../utils/Utils.hpp"
+
+// generations evolved between checks of the time budget when the islands never migrate
+#define UNMIGRATED_EPOCH 10
+
+/**
+ * @brief creates a new GeneticAlgorithm solver
+ * @param matrix fully populated distance matrix (shared, read-only, by every island)
+ * @param config size of the islands, migration policy, mutation rate and time budget
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ */
+GeneticAlgorithm::GeneticAlgorithm(const DistanceMatrix &matrix, const Config &config, Progress *progress)
+    : matrix(matrix), config(config), progress(progress) {}
+
+/**
+ * @brief computes the length of a tour
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ * @return length of the tour
+ */
+double GeneticAlgorithm::length(const std::vector<int> &order) const {
+    double res = 0;
+
+    for (size_t i = 0; i < order.size(); ++i)
+        res += matrix(order[i], order[(i + 1) % order.size()]);
+
+    return res;
+}
+
+/**
+ * @brief hashes a tour in its canonical form, starting at its smallest vertex and going towards the smaller of its
+ * neighbours, so that the same cycle has the same hash however it is stored
+ * @complexity O(|V|)
+ * @param order std::vector containing the indices of the vertices in the order they are visited
+ * @return hash of the tour
+ */
+uint64_t GeneticAlgorithm::fingerprint(const std::vector<int> &order) {
+    int n = (int) order.size();
+    int start = (int) (std::min_element(order.begin(), order.end()) - order.begin());
+    int step = (order[(start + 1) % n] < order[(start + n - 1) % n]) ? 1 : n - 1;
+
+    uint64_t h = Utils::hash(&order[start], sizeof(int));
+
+    for (int k = 1, i = (start + step) % n; k < n; ++k, i = (i + step) % n)
+        h = Utils::hash(&order[i], sizeof(int), h);
+
+    return h;
+}
+
+/**
+ * @brief creates a child using order crossover (OX), which copies a random section of one parent and fills the
+ * remaining positions with the other vertices, in the order they appear in the other parent
+ * @complexity O(|V|)
+ * @param lhs first parent
+ * @param rhs second parent
+ * @param child std::vector where the child will be stored
+ * @param used buffer (with one entry per vertex) used to mark the copied vertices
+ * @param rng random number generator
+ */
+void GeneticAlgorithm::crossover(const std::vector<int> &lhs, const std::vector<int> &rhs, std::vector<int> &child,
+                                 std::vector<char> &used, XorShift &rng) const {
+    int n = (int) lhs.size();
+
+    int i = rng.nextInt(n), j = rng.nextInt(n);
+    if (i > j) std::swap(i, j);
+
+    child.assign(n, 0);
+    std::fill(used.begin(), used.end(), false);
+
+    for (int k = i; k <= j; ++k) {
+        child[k] = lhs[k];
+        used[lhs[k]] = true;
+    }
+
+    int pos = (j + 1) % n;
+    for (int k = 0; k < n; ++k) {
+        int v = rhs[(j + 1 + k) % n];
+        if (used[v]) continue;
+
+        child[pos] = v;
+        pos = (pos + 1) % n;
+    }
+}
+
+/**
+ * @brief selects an individual of an island using a binary tournament
+ * @param island island where the individual will be selected
+ * @return index of the selected individual
+ */
+int GeneticAlgorithm::select(Island &island) {
+    int size = (int) island.population.size();
+
+    int a = island.rng.nextInt(size), b = island.rng.nextInt(size);
+    return (island.population[a].length < island.population[b].length) ? a : b;
+}
+
+/**
+ * @brief evolves an island for a number of generations, in which each generation creates as many children as there
+ * are individuals, each replacing the worst individual of the island if it is better (and not a duplicate)
+ * @param island island to be evolved
+ * @param generations number of generations
+ */
+void GeneticAlgorithm::evolve(Island &island, int generations) const {
+    int n = (int) island.population.front().order.size();
+
+    LocalSearch search(matrix, candidates);
+    std::vector<char> used(matrix.dimension());
+    std::vector<int> child;
+
+    for (int g = 0; g < generations; ++g) {
+        for (size_t c = 0; c < island.population.size(); ++c) {
+            const Individual &lhs = island.population[select(island)];
+            const Individual &rhs = island.population[select(island)];
+
+            crossover(lhs.order, rhs.order, child, used, island.rng);
+
+            // mutate with a random 2-opt move, then optimize the child with 2-opt
+            if (n > 3 && island.rng.nextDouble() < config.mutationRate) {
+                int i = island.rng.nextInt(n), j = island.rng.nextInt(n);
+                std::reverse(child.begin() + std::min(i, j), child.begin() + std::max(i, j) + 1);
+            }
+
+            ArrayTour tour(child);
+            search.activateAll();
+
+            Individual offspring = {{}, search.twoOpt(tour, search.length(tour)), 0};
+            offspring.order = tour.toVector(tour.at(0));
+            offspring.hash = fingerprint(offspring.order);
+
+            auto worst = std::max_element(island.population.begin(), island.population.end(),
+                                          [](const Individual &a, const Individual &b) { return a.length < b.length; });
+
+            bool duplicate = std::any_of(island.population.begin(), island.population.end(),
+                                         [&offspring](const Individual &i) { return i.hash == offspring.hash; });
+
+            if (!duplicate && offspring.length < worst->length)
+                *worst = std::move(offspring);
+        }
+    }
+}
+
+/**
+ * @brief evolves a population of tours, split into islands that evolve in parallel (on the shared ThreadPool) and that,
+ * periodically, send their best individuals to the next island (in a ring), replacing its worst ones
+ * @note if the migration interval is 0, the islands never migrate, and the time budget is checked every
+ * UNMIGRATED_EPOCH generations instead
+ * @param seeds initial tours (e.g. computed by the Nearest-Neighbour heuristic), perturbed to fill the islands
+ * @param best std::vector where the best tour found will be stored
+ * @return length of the best tour found
+ */
+double GeneticAlgorithm::run(const std::vector<std::vector<int>> &seeds, std::vector<int> &best) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(config.timeLimit));
+
+    ThreadPool &pool = ThreadPool::shared();
+    int count = config.islands ? config.islands : pool.size();
+    int n = (int) seeds.front().size();
+
+    XorShift rng(config.seed);
+
+    // fill the islands with the seeds, perturbing the repeated ones with random 2-opt moves
+    std::vector<Island> islands(count);
+
+    for (int i = 0, s = 0; i < count; ++i) {
+        islands[i].rng = XorShift(rng.next());
+
+        for (int k = 0; k < config.populationSize; ++k, ++s) {
+            Individual individual = {seeds[s % seeds.size()], 0, 0};
+
+            for (int m = 0; n > 3 && m < s / (int) seeds.size(); ++m) {
+                int a = rng.nextInt(n), b = rng.nextInt(n);
+                std::reverse(individual.order.begin() + std::min(a, b), individual.order.begin() + std::max(a, b) + 1);
+            }
+
+            individual.length = length(individual.order);
+            individual.hash = fingerprint(individual.order);
+            islands[i].population.push_back(std::move(individual));
+        }
+    }
+
+    // choose the candidates of the 2-opt, reporting the Held-Karp bound if it is computed
+    if (config.alphaNearness) {
+        double upperBound = std::numeric_limits<double>::infinity();
+
+        for (const Island &island : islands)
+            for (const Individual &individual : island.population)
+                upperBound = std::min(upperBound, individual.length);
+
+        HeldKarp heldKarp(matrix, HeldKarp::Config());
+        double bound = heldKarp.optimize(upperBound);
+
+        if (progress) progress->setBound(bound);
+        candidates = heldKarp.candidates(config.candidates);
+    }
+    else candidates = Candidates::nearest(matrix, config.candidates);
+
+    auto bestOf = [](const Island &island) {
+        return std::min_element(island.population.begin(), island.population.end(),
+                                [](const Individual &a, const Individual &b) { return a.length < b.length; });
+    };
+
+    for (int generation = 0; !config.generations || generation < config.generations;) {
+        if (std::chrono::steady_clock::now() >= deadline || Progress::isCancelled(progress)) break;
+
+        int epoch = (config.migrationInterval > 0) ? config.migrationInterval : UNMIGRATED_EPOCH;
+        if (config.generations) epoch = std::min(epoch, config.generations - generation);
+
+        // evolve the islands in parallel
+        pool.parallelFor(count, [this, &islands, epoch](int i) {
+            TRACE_SCOPE("evolve island", i);
+            evolve(islands[i], epoch);
+        });
+
+        generation += epoch;
+
+        // migrate the best individuals of each island to the next one, replacing its worst individuals
+        {
+            TRACE_SCOPE("migrate");
+
+            int migrants = std::min(config.migrants, config.populationSize);
+            std::vector<std::vector<Individual>> outgoing(count);
+
+            bool migrating = (count > 1 && config.migrationInterval > 0);
+
+            for (int i = 0; migrating && i < count; ++i) {
+                std::vector<Individual> &population = islands[i].population;
+
+                std::sort(population.begin(), population.end(),
+                          [](const Individual &a, const Individual &b) { return a.length < b.length; });
+
+                outgoing[i].assign(population.begin(), population.begin() + migrants);
+            }
+
+            // a migrant that the island already holds is skipped, so that the migrations do not fill it with copies
+            for (int i = 0; migrating && i < count; ++i) {
+                std::vector<Individual> &population = islands[(i + 1) % count].population;
+                auto worst = population.end();
+
+                for (const Individual &migrant : outgoing[i]) {
+                    bool duplicate = std::any_of(population.begin(), population.end(),
+                                                 [&migrant](const Individual &j) { return j.hash == migrant.hash; });
+
+                    if (!duplicate) *--worst = migrant;
+                }
+            }
+        }
+
+        double length = bestOf(islands[0])->length;
+
+        for (const Island &island : islands)
+            length = std::min(length, bestOf(island)->length);
+
+        Progress::improve(progress, length);
+        Progress::advance(progress, epoch);
+    }
+
+    const Individual *res = &*bestOf(islands[0]);
+
+    for (const Island &island : islands)
+        if (bestOf(island)->length < res->length) res = &*bestOf(island);
+
+    best = res->order;
+    return res->length;
+}
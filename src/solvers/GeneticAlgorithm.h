@@ -0,0 +1,62 @@
+#ifndef DA_PROJ2_GENETICALGORITHM_H
+#define DA_PROJ2_GENETICALGORITHM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Budget.h"
+#include "../network/DistanceMatrix.h"
+#include "../utils/Progress.h"
+#include "../utils/Random.hpp"
+
+class GeneticAlgorithm {
+/* ATTRIBUTES */
+public:
+    struct Config : Budget {
+        int islands = 0;              // 0 uses one island per worker of the shared ThreadPool
+        int populationSize = 30;      // individuals per island
+        int generations = 0;          // 0 runs until the time budget runs out
+        int migrationInterval = 10;   // generations between migrations (0 never migrates, so the islands evolve apart)
+        int migrants = 2;             // individuals sent to the next island on each migration
+        double mutationRate = 0.2;    // probability of applying a random 2-opt move to each child
+        int candidates = 10;          // size of the candidate list of each vertex (used by the 2-opt)
+        bool alphaNearness = true;    // indicates if the candidates are chosen by alpha-nearness instead of distance
+
+        Config() : Budget(30) {}
+    };
+
+private:
+    struct Individual {
+        std::vector<int> order;
+        double length;
+        uint64_t hash;                // of the tour, regardless of its first vertex and direction (see fingerprint)
+    };
+
+    struct Island {
+        std::vector<Individual> population;
+        XorShift rng;
+    };
+
+    const DistanceMatrix &matrix;
+    Config config;
+    Progress *progress;
+    std::vector<std::vector<int>> candidates;
+
+/* CONSTRUCTOR */
+public:
+    GeneticAlgorithm(const DistanceMatrix &matrix, const Config &config, Progress *progress = nullptr);
+
+/* METHODS */
+private:
+    double length(const std::vector<int> &order) const;
+    static uint64_t fingerprint(const std::vector<int> &order);
+    void crossover(const std::vector<int> &lhs, const std::vector<int> &rhs, std::vector<int> &child,
+                   std::vector<char> &used, XorShift &rng) const;
+    void evolve(Island &island, int generations) const;
+    static int select(Island &island);
+
+public:
+    double run(const std::vector<std::vector<int>> &seeds, std::vector<int> &best);
+};
+
+#endif //DA_PROJ2_GENETICALGORITHM_H
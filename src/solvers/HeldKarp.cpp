@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "HeldKarp.h"
+
+/**
+ * @brief creates a new HeldKarp lower bound engine, with every penalty set to zero
+ * @param matrix fully populated distance matrix
+ * @param config number of subgradient steps and time budget
+ */
+HeldKarp::HeldKarp(const DistanceMatrix &matrix, const Config &config)
+    : matrix(matrix), config(config), n(matrix.dimension() - 1), pi(n + 1), bound(0), parent(n + 1),
+      parentCost(n + 1), degree(n + 1), special{0, 0}, secondCost(0) {}
+
+/**
+ * @brief computes the penalized distance between two vertices
+ * @param src index of the source vertex
+ * @param dest index of the destination vertex
+ * @return distance between the two vertices, plus the penalty of each of them
+ */
+double HeldKarp::cost(int src, int dest) const {
+    return matrix(src, dest) + pi[src] + pi[dest];
+}
+
+/**
+ * @brief computes a minimum 1-tree for the current penalties, using Prim's algorithm for the spanning tree of every
+ * vertex but the first and then connecting the first vertex through its two shortest edges
+ * @complexity O(|V|^2)
+ * @return weight of the 1-tree minus twice the sum of the penalties, i.e. a lower bound on the length of the optimal
+ * tour
+ */
+double HeldKarp::oneTree() {
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::fill(degree.begin(), degree.end(), 0);
+    order.clear();
+
+    std::vector<double> key(n + 1, inf);
+    std::vector<int> remaining;
+
+    for (int v = 3; v <= n; ++v)
+        remaining.push_back(v);
+
+    double res = 0;
+
+    // spanning tree of every vertex but the first, rooted at the second
+    for (int u = 2; u; ) {
+        order.push_back(u);
+
+        if (parent[u]) {
+            ++degree[u];
+            ++degree[parent[u]];
+            res += parentCost[u];
+        }
+
+        int next = 0;
+        size_t index = 0;
+
+        for (size_t i = 0; i < remaining.size(); ++i) {
+            int v = remaining[i];
+            double c = cost(u, v);
+
+            if (c < key[v]) {
+                key[v] = c;
+                parent[v] = u;
+                parentCost[v] = c;
+            }
+
+            if (!next || key[v] < key[next]) {
+                next = v;
+                index = i;
+            }
+        }
+
+        if (next) {
+            remaining[index] = remaining.back();
+            remaining.pop_back();
+        }
+
+        u = next;
+    }
+
+    parent[2] = 0;
+
+    // connect the first vertex through its two shortest edges
+    double first = inf, second = inf;
+    special[0] = special[1] = 0;
+
+    for (int v = 2; v <= n; ++v) {
+        double c = cost(1, v);
+
+        if (c < first) {
+            second = first;
+            special[1] = special[0];
+
+            first = c;
+            special[0] = v;
+        }
+        else if (c < second) {
+            second = c;
+            special[1] = v;
+        }
+    }
+
+    degree[1] = 2;
+    ++degree[special[0]];
+    ++degree[special[1]];
+
+    secondCost = second;
+    res += first + second;
+
+    for (int v = 1; v <= n; ++v)
+        res -= 2 * pi[v];
+
+    return res;
+}
+
+/**
+ * @brief computes the Held-Karp lower bound, using subgradient optimization: the penalties of the vertices whose
+ * degree in the minimum 1-tree is above 2 are raised (and those below 2 are lowered), so that the 1-tree gets closer
+ * to a tour, with the step size given by Polyak's rule and halved whenever the bound stops improving
+ * @note on return, the penalties (and the 1-tree) are the ones that yielded the best bound
+ * @complexity O(I * |V|^2), where I is the number of iterations
+ * @param upperBound length of a known tour (0 estimates it from the first 1-tree)
+ * @return lower bound on the length of the optimal tour (0 if the graph has less than 3 vertices)
+ */
+double HeldKarp::optimize(double upperBound) {
+    if (n < 3) return bound = 0;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(config.timeLimit));
+
+    double weight = oneTree();
+    bound = weight;
+
+    if (upperBound <= 0) upperBound = 1.25 * weight;
+
+    std::vector<double> bestPi = pi;
+    std::vector<int> lastDirection(n + 1, 0);
+
+    double lambda = 2;
+    int patience = std::max(10, n / 20), stale = 0;
+
+    for (int it = 0; it < config.iterations && lambda > 1e-6; ++it) {
+        if (!(it & 7) && std::chrono::steady_clock::now() >= deadline) break;
+
+        long long norm = 0;
+        for (int v = 1; v <= n; ++v)
+            norm += (long long) (degree[v] - 2) * (degree[v] - 2);
+
+        // the 1-tree is a tour, so the bound is optimal
+        if (!norm || weight >= upperBound) break;
+
+        double step = lambda * (upperBound - weight) / (double) norm;
+
+        // move along the subgradient, smoothed by the previous direction
+        for (int v = 1; v <= n; ++v) {
+            int direction = degree[v] - 2;
+
+            pi[v] += step * (0.7 * direction + 0.3 * lastDirection[v]);
+            lastDirection[v] = direction;
+        }
+
+        weight = oneTree();
+
+        if (weight > bound) {
+            bound = weight;
+            bestPi = pi;
+            stale = 0;
+        }
+        else if (++stale >= patience) {
+            lambda /= 2;
+            stale = 0;
+        }
+    }
+
+    pi = bestPi;
+    oneTree();
+
+    return bound;
+}
+
+/**
+ * @brief returns the best lower bound found
+ * @return lower bound on the length of the optimal tour
+ */
+double HeldKarp::getBound() const {
+    return bound;
+}
+
+/**
+ * @brief returns the penalty of each vertex
+ * @return std::vector containing the penalty of each vertex
+ */
+const std::vector<double> &HeldKarp::getPi() const {
+    return pi;
+}
+
+/**
+ * @brief computes the candidate list of each vertex using the alpha-nearness of its edges, i.e. how much the minimum
+ * 1-tree (for the current penalties) would grow if it was forced to contain the edge, which is a much better predictor
+ * of the edges of the optimal tour than the distance
+ * @note the alpha-nearness of an edge outside the tree is its penalized distance minus the longest edge in the path of
+ * the tree between its endpoints, which is computed for every endpoint by visiting the tree from the root
+ * @complexity O(|V|^2 * log(k))
+ * @param k number of candidates of each vertex
+ * @return std::vector containing the candidates of each vertex, sorted by alpha-nearness (and then by distance)
+ */
+std::vector<std::vector<int>> HeldKarp::candidates(int k) const {
+    k = std::min(k, n - 1);
+
+    std::vector<std::vector<int>> res(n + 1);
+    if (k <= 0) return res;
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> alpha(n + 1), beta(n + 1);
+    std::vector<int> mark(n + 1, 0), others;
+    others.reserve(n);
+
+    for (int v = 1; v <= n; ++v) {
+        if (v == 1) {
+            // the edges of the first vertex may only replace the longest of its two edges
+            for (int u = 2; u <= n; ++u)
+                alpha[u] = (u == special[0] || u == special[1]) ? 0 : cost(1, u) - secondCost;
+        }
+        else {
+            // longest edge in the path of the tree between v and every other vertex, starting with its ancestors
+            beta[v] = -inf;
+            mark[v] = v;
+
+            for (int u = v; parent[u]; u = parent[u]) {
+                beta[parent[u]] = std::max(beta[u], parentCost[u]);
+                mark[parent[u]] = v;
+            }
+
+            for (int u : order)
+                if (mark[u] != v) beta[u] = std::max(beta[parent[u]], parentCost[u]);
+
+            for (int u = 2; u <= n; ++u)
+                if (u != v) alpha[u] = cost(v, u) - beta[u];
+
+            alpha[1] = (v == special[0] || v == special[1]) ? 0 : cost(1, v) - secondCost;
+        }
+
+        others.clear();
+
+        for (int u = 1; u <= n; ++u)
+            if (u != v) others.push_back(u);
+
+        std::partial_sort(others.begin(), others.begin() + k, others.end(), [this, &alpha, v](int a, int b) {
+            return alpha[a] < alpha[b] || (alpha[a] == alpha[b] && matrix(v, a) < matrix(v, b));
+        });
+
+        res[v].assign(others.begin(), others.begin() + k);
+    }
+
+    return res;
+}
@@ -0,0 +1,48 @@
+#ifndef DA_PROJ2_HELDKARP_H
+#define DA_PROJ2_HELDKARP_H
+
+#include <vector>
+
+#include "../network/DistanceMatrix.h"
+
+class HeldKarp {
+/* ATTRIBUTES */
+public:
+    struct Config {
+        int iterations = 1000;      // maximum number of subgradient steps (0 computes a single 1-tree)
+        double timeLimit = 1;       // in seconds
+    };
+
+private:
+    const DistanceMatrix &matrix;
+    Config config;
+    int n;
+
+    std::vector<double> pi;         // penalty of each vertex, added to the distance of each of its edges
+    double bound;                   // best lower bound found
+
+    // minimum 1-tree for the current penalties: spanning tree of every vertex but the first, rooted at the second
+    std::vector<int> parent;        // parent of each vertex in the tree (0 for the root and the first vertex)
+    std::vector<double> parentCost; // penalized distance between each vertex and its parent
+    std::vector<int> order;         // vertices of the tree, in the order they were added (parents before children)
+    std::vector<int> degree;        // degree of each vertex in the 1-tree
+    int special[2];                 // endpoints of the two edges of the first vertex
+    double secondCost;              // penalized distance of the longest of these two edges
+
+/* CONSTRUCTOR */
+public:
+    HeldKarp(const DistanceMatrix &matrix, const Config &config);
+
+/* METHODS */
+private:
+    double cost(int src, int dest) const;
+    double oneTree();
+
+public:
+    double optimize(double upperBound = 0);
+    double getBound() const;
+    const std::vector<double> &getPi() const;
+    std::vector<std::vector<int>> candidates(int k) const;
+};
+
+#endif //DA_PROJ2_HELDKARP_H
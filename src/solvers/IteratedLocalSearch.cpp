@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <chrono>
+
+#include "Candidates.h"
+#include "HeldKarp.h"
+#include "IteratedLocalSearch.h"
+#include "LocalSearch.h"
+#include "../network/ArrayTour.h"
+#include "../utils/Random.hpp"
+
+/**
+ * @brief creates a new IteratedLocalSearch solver
+ * @param matrix fully populated distance matrix
+ * @param config size of the candidate lists, strength of the kicks and time budget
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ */
+IteratedLocalSearch::IteratedLocalSearch(const DistanceMatrix &matrix, const Config &config, Progress *progress)
+    : matrix(matrix), config(config), progress(progress) {}
+
+/**
+ * @brief improves a tour using iterated local search, using either the edges of each vertex with the lowest
+ * alpha-nearness (reporting the Held-Karp bound computed along the way) or its nearest neighbours as candidates
+ * @param order std::vector containing the initial tour, where the best tour found will be stored
+ * @return length of the best tour found
+ */
+double IteratedLocalSearch::run(std::vector<int> &order) {
+    if (!config.alphaNearness) return run(order, Candidates::nearest(matrix, config.candidates));
+
+    double length = 0;
+    for (size_t i = 0; i < order.size(); ++i)
+        length += matrix(order[i], order[(i + 1) % order.size()]);
+
+    HeldKarp heldKarp(matrix, HeldKarp::Config());
+    double bound = heldKarp.optimize(length);
+
+    if (progress) progress->setBound(bound);
+    return run(order, heldKarp.candidates(config.candidates));
+}
+
+/**
+ * @brief improves a tour using iterated local search, which repeatedly perturbs the best tour with a random
+ * double-bridge kick and re-optimizes it with 2-opt, only around the vertices touched by the kick
+ * @param order std::vector containing the initial tour, where the best tour found will be stored
+ * @param candidates candidate list of each vertex, sorted by distance
+ * @return length of the best tour found
+ */
+double IteratedLocalSearch::run(std::vector<int> &order, const std::vector<std::vector<int>> &candidates) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(config.timeLimit));
+
+    int n = (int) order.size();
+
+    ArrayTour tour(order);
+    LocalSearch search(matrix, candidates);
+    XorShift rng(config.seed);
+
+    // start from a local optimum
+    search.activateAll();
+    double length = search.twoOpt(tour, search.length(tour));
+
+    // the changes of each kick are recorded, so that a rejected one is undone rather than the best tour copied back
+    tour.mark();
+    double bestLength = length;
+    Progress::improve(progress, bestLength);
+
+    for (long long it = 0; n >= 8 && (!config.iterations || it < config.iterations); ++it) {
+        if (!(it & 63)) {
+            if (std::chrono::steady_clock::now() >= deadline || Progress::isCancelled(progress)) break;
+            if (it) Progress::advance(progress, 64);
+        }
+
+        // double-bridge kick: A B C D -> A C B D, with B = [i, j[ and C = [j, k[
+        int maxLength = std::max(1, std::min(config.kickLength, (n - 2) / 2));
+
+        int i = 1 + rng.nextInt(n - 2 * maxLength - 1 > 0 ? n - 2 * maxLength - 1 : 1);
+        int j = i + 1 + rng.nextInt(maxLength);
+        int k = j + 1 + rng.nextInt(maxLength);
+        if (k > n) continue;
+
+        int touched[] = {tour.at(i - 1), tour.at(i), tour.at(j - 1), tour.at(j), tour.at(k - 1), tour.at(k % n)};
+
+        double added[] = {matrix(touched[0], touched[3]), matrix(touched[4], touched[1]),
+                          matrix(touched[2], touched[5])};
+        double removed[] = {matrix(touched[0], touched[1]), matrix(touched[2], touched[3]),
+                            matrix(touched[4], touched[5])};
+
+        // never add a missing edge, while removing one is always accepted (and the length is then recomputed)
+        if (std::any_of(added, added + 3, DistanceMatrix::isMissing)) continue;
+        bool exact = std::any_of(removed, removed + 3, DistanceMatrix::isMissing);
+
+        tour.exchange(i, j, k);
+
+        if (exact) length = search.length(tour);
+        else length += added[0] + added[1] + added[2] - removed[0] - removed[1] - removed[2];
+
+        // re-optimize only around the kick
+        for (int v : touched)
+            search.activate(v);
+
+        length = search.twoOpt(tour, length);
+
+        if (length < bestLength - 1e-9) {
+            tour.mark();
+            bestLength = length;
+            Progress::improve(progress, bestLength);
+        }
+        else {
+            tour.rollback();
+            length = bestLength;
+        }
+    }
+
+    order = tour.toVector(tour.at(0));
+    return bestLength;
+}
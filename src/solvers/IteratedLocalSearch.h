@@ -0,0 +1,37 @@
+#ifndef DA_PROJ2_ITERATEDLOCALSEARCH_H
+#define DA_PROJ2_ITERATEDLOCALSEARCH_H
+
+#include <vector>
+
+#include "Budget.h"
+#include "../network/DistanceMatrix.h"
+#include "../utils/Progress.h"
+
+class IteratedLocalSearch {
+/* ATTRIBUTES */
+public:
+    struct Config : Budget {
+        int candidates = 10;        // size of the candidate list of each vertex
+        bool alphaNearness = true;  // indicates if the candidates are chosen by alpha-nearness instead of distance
+        int kickLength = 50;        // maximum length of each section moved by a double-bridge kick
+        long long iterations = 0;   // 0 runs until the time budget runs out
+
+        Config() : Budget(5) {}
+    };
+
+private:
+    const DistanceMatrix &matrix;
+    Config config;
+    Progress *progress;
+
+/* CONSTRUCTOR */
+public:
+    IteratedLocalSearch(const DistanceMatrix &matrix, const Config &config, Progress *progress = nullptr);
+
+/* METHODS */
+public:
+    double run(std::vector<int> &order);
+    double run(std::vector<int> &order, const std::vector<std::vector<int>> &candidates);
+};
+
+#endif //DA_PROJ2_ITERATEDLOCALSEARCH_H
@@ -0,0 +1,114 @@
+#include "LocalSearch.h"
+
+/**
+ * @brief creates a new LocalSearch, which runs 2-opt restricted to candidate lists and guided by don't-look bits
+ * @param matrix fully populated distance matrix
+ * @param candidates candidate list of each vertex, sorted by distance
+ */
+LocalSearch::LocalSearch(const DistanceMatrix &matrix, const std::vector<std::vector<int>> &candidates)
+    : matrix(matrix), candidates(candidates), active(candidates.size(), false) {}
+
+/**
+ * @brief turns off the don't-look bit of a vertex, so that it is (re)examined by the next search
+ * @param v index of the vertex
+ */
+void LocalSearch::activate(int v) {
+    if (active[v]) return;
+
+    active[v] = true;
+    queue.push_back(v);
+}
+
+/**
+ * @brief turns off the don't-look bit of every vertex
+ */
+void LocalSearch::activateAll() {
+    for (int v = 1; v < (int) candidates.size(); ++v)
+        activate(v);
+}
+
+/**
+ * @brief looks for an improving 2-opt move that adds an edge between a vertex and one of its candidates, applying the
+ * first one that is found
+ * @param tour tour to be improved
+ * @param a index of the vertex
+ * @param gain double where the gain of the move will be added
+ * @param exact bool that is set if the move removed a missing edge (whose gain is not added, as it would be INF)
+ * @return 'true' if a move was applied, 'false' otherwise
+ */
+bool LocalSearch::improve(ArrayTour &tour, int a, double &gain, bool &exact) {
+    for (int succ = 1; succ >= 0; --succ) {
+        int b = succ ? tour.next(a) : tour.prev(a);
+        double ab = matrix(a, b);
+
+        for (int c : candidates[a]) {
+            double ac = matrix(a, c);
+            if (ac >= ab) break; // the candidates are sorted, so no other one can lead to a gain
+
+            int d = succ ? tour.next(c) : tour.prev(c);
+            if (c == b || d == a) continue;
+
+            double cd = matrix(c, d), bd = matrix(b, d);
+
+            // never add a missing edge, while removing one is always accepted (and the length is then recomputed, as
+            // an incremental update would be swallowed by INF)
+            if (DistanceMatrix::isMissing(ac) || DistanceMatrix::isMissing(bd)) continue;
+
+            bool removesMissing = DistanceMatrix::isMissing(ab) || DistanceMatrix::isMissing(cd);
+            double delta = ab + cd - ac - bd;
+            if (!removesMissing && delta <= 1e-9) continue;
+
+            // a b ... c d -> a c ... b d  or  b a ... d c -> b d ... a c
+            succ ? tour.reverse(b, c) : tour.reverse(a, d);
+
+            if (removesMissing) exact = true;
+            else gain += delta;
+
+            activate(b);
+            activate(c);
+            activate(d);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief computes the length of a tour
+ * @complexity O(|V|)
+ * @param tour tour whose length will be computed
+ * @return length of the tour (INF, or more, if it uses a missing edge)
+ */
+double LocalSearch::length(const ArrayTour &tour) const {
+    double res = 0;
+
+    for (int i = 0, n = tour.size(); i < n; ++i)
+        res += matrix(tour.at(i), tour.at((i + 1) % n));
+
+    return res;
+}
+
+/**
+ * @brief optimizes a tour using 2-opt, examining only the vertices whose don't-look bit is off (and the ones touched by
+ * each improving move)
+ * @complexity O(k) per examined vertex, plus the cost of each reversal (and O(|V|) if a missing edge is removed)
+ * @param tour tour to be optimized
+ * @param length length of the tour before it is optimized
+ * @return length of the optimized tour
+ */
+double LocalSearch::twoOpt(ArrayTour &tour, double length) {
+    double gain = 0;
+    bool exact = false;
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        int a = queue[i];
+        active[a] = false;
+
+        if (improve(tour, a, gain, exact)) activate(a);
+    }
+
+    queue.clear();
+    return exact ? this->length(tour) : length - gain;
+}
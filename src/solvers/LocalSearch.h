@@ -0,0 +1,33 @@
+#ifndef DA_PROJ2_LOCALSEARCH_H
+#define DA_PROJ2_LOCALSEARCH_H
+
+#include <vector>
+
+#include "../network/ArrayTour.h"
+#include "../network/DistanceMatrix.h"
+
+class LocalSearch {
+/* ATTRIBUTES */
+private:
+    const DistanceMatrix &matrix;
+    const std::vector<std::vector<int>> &candidates;
+
+    std::vector<char> active; // don't-look bits (inverted)
+    std::vector<int> queue;   // vertices whose don't-look bit is off
+
+/* CONSTRUCTOR */
+public:
+    LocalSearch(const DistanceMatrix &matrix, const std::vector<std::vector<int>> &candidates);
+
+/* METHODS */
+private:
+    bool improve(ArrayTour &tour, int a, double &gain, bool &exact);
+
+public:
+    void activate(int v);
+    void activateAll();
+    double length(const ArrayTour &tour) const;
+    double twoOpt(ArrayTour &tour, double length);
+};
+
+#endif //DA_PROJ2_LOCALSEARCH_H
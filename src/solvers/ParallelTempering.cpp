@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cmath>
+
+#include "Annealer.h"
+#include "ParallelTempering.h"
+#include "../parallel/ThreadPool.h"
+#include "../utils/Tracer.h"
+
+/**
+ * @brief creates a new ParallelTempering solver
+ * @param matrix fully populated distance matrix (shared, read-only, by every replica)
+ * @param config number of replicas (or the least number of them, when there is one per worker), temperature ladder
+ * and time budget
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ */
+ParallelTempering::ParallelTempering(const DistanceMatrix &matrix, const Config &config, Progress *progress)
+    : matrix(matrix), config(config), progress(progress) {}
+
+/**
+ * @brief improves a tour using parallel tempering, in which each replica anneals its own copy of the tour at a fixed
+ * temperature (in parallel, on the shared ThreadPool) and, periodically, replicas at neighbouring temperatures
+ * exchange their tours
+ * @param order std::vector containing the initial tour, where the best tour found will be stored
+ * @return length of the best tour found
+ */
+double ParallelTempering::run(std::vector<int> &order) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(config.timeLimit));
+
+    ThreadPool &pool = ThreadPool::shared();
+
+    int count = config.replicas ? config.replicas : std::max(config.minReplicas, pool.size());
+    int moves = config.movesPerExchange ? config.movesPerExchange : (int) order.size();
+
+    XorShift rng(config.seed);
+
+    std::vector<Annealer> replicas;
+    replicas.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+        replicas.emplace_back(matrix, order, rng.next());
+
+    // geometric temperature ladder, from the hottest to the coldest replica
+    double maxTemperature = config.maxTemperature;
+    if (maxTemperature <= 0) maxTemperature = replicas[0].sampleTemperature(1000, 0.5);
+
+    std::vector<double> temperatures(count, maxTemperature);
+    double ratio = (count > 1) ? std::pow(config.minTemperature, 1.0 / (count - 1)) : 1;
+
+    for (int i = 1; i < count; ++i)
+        temperatures[i] = temperatures[i - 1] * ratio;
+
+    while (std::chrono::steady_clock::now() < deadline && !Progress::isCancelled(progress)) {
+        // anneal the replicas in parallel
+        pool.parallelFor(count, [&replicas, &temperatures, moves](int i) {
+            TRACE_SCOPE("anneal replica", i);
+
+            for (int k = 0; k < moves; ++k)
+                replicas[i].step(temperatures[i]);
+        });
+
+        // attempt to exchange the tours of neighbouring replicas (which is the serial part of each round)
+        {
+            TRACE_SCOPE("exchange replicas");
+
+            for (int i = 0; i + 1 < count; ++i) {
+                double exponent = (1 / temperatures[i] - 1 / temperatures[i + 1]) *
+                                  (replicas[i].getLength() - replicas[i + 1].getLength());
+
+                if (exponent >= 0 || rng.nextDouble() < std::exp(exponent))
+                    replicas[i].swap(replicas[i + 1]);
+            }
+        }
+
+        for (const Annealer &replica : replicas)
+            Progress::improve(progress, replica.getBestLength());
+
+        Progress::advance(progress, (long long) count * moves);
+    }
+
+    const Annealer *best = &replicas[0];
+    for (const Annealer &replica : replicas)
+        if (replica.getBestLength() < best->getBestLength()) best = &replica;
+
+    order = best->getBestOrder();
+    return best->getBestLength();
+}
@@ -0,0 +1,37 @@
+#ifndef DA_PROJ2_PARALLELTEMPERING_H
+#define DA_PROJ2_PARALLELTEMPERING_H
+
+#include <vector>
+
+#include "Budget.h"
+#include "../network/DistanceMatrix.h"
+#include "../utils/Progress.h"
+
+class ParallelTempering {
+/* ATTRIBUTES */
+public:
+    struct Config : Budget {
+        int replicas = 0;               // 0 uses one replica per worker of the shared ThreadPool (at least minReplicas)
+        int minReplicas = 4;            // so that, with few workers, the ladder still has temperatures between the ends
+        double maxTemperature = 0;      // 0 estimates it from the tour, so that about half the worse moves are accepted
+        double minTemperature = 1e-3;   // relative to the maximum temperature
+        int movesPerExchange = 0;       // 0 uses |V|
+
+        Config() : Budget(5) {}
+    };
+
+private:
+    const DistanceMatrix &matrix;
+    Config config;
+    Progress *progress;
+
+/* CONSTRUCTOR */
+public:
+    ParallelTempering(const DistanceMatrix &matrix, const Config &config, Progress *progress = nullptr);
+
+/* METHODS */
+public:
+    double run(std::vector<int> &order);
+};
+
+#endif //DA_PROJ2_PARALLELTEMPERING_H
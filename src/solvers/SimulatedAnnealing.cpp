@@ -0,0 +1,53 @@
+#include <chrono>
+
+#include "Annealer.h"
+#include "SimulatedAnnealing.h"
+
+/**
+ * @brief creates a new SimulatedAnnealing solver
+ * @param matrix fully populated distance matrix
+ * @param schedule cooling schedule and time budget
+ * @param progress channel through which the best length is reported and the run is cancelled (may be nullptr)
+ */
+SimulatedAnnealing::SimulatedAnnealing(const DistanceMatrix &matrix, const Config &schedule, Progress *progress)
+    : matrix(matrix), schedule(schedule), progress(progress) {}
+
+/**
+ * @brief improves a tour using simulated annealing with a geometric cooling schedule, stopping once the final
+ * temperature is reached, the time budget runs out or the run is cancelled
+ * @param order std::vector containing the initial tour, where the best tour found will be stored
+ * @return length of the best tour found
+ */
+double SimulatedAnnealing::run(std::vector<int> &order) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(schedule.timeLimit));
+
+    Annealer annealer(matrix, order, schedule.seed);
+
+    double temperature = schedule.initialTemperature;
+    if (temperature <= 0) temperature = annealer.sampleTemperature(1000, 0.5);
+
+    double finalTemperature = temperature * schedule.finalTemperature;
+    int moves = schedule.movesPerEpoch ? schedule.movesPerEpoch : 10 * (int) order.size();
+
+    for (bool timeout = false; !timeout && temperature > finalTemperature; temperature *= schedule.coolingRate) {
+        int i = 0;
+
+        for (; i < moves; ++i) {
+            annealer.step(temperature);
+
+            // only check the clock every once in a while, as it is expensive compared to a step
+            if (!(i & 1023) && (std::chrono::steady_clock::now() >= deadline || Progress::isCancelled(progress))) {
+                timeout = true;
+                break;
+            }
+        }
+
+        Progress::improve(progress, annealer.getBestLength());
+        Progress::advance(progress, i);
+    }
+
+    order = annealer.getBestOrder();
+    return annealer.getBestLength();
+}
@@ -0,0 +1,36 @@
+#ifndef DA_PROJ2_SIMULATEDANNEALING_H
+#define DA_PROJ2_SIMULATEDANNEALING_H
+
+#include <vector>
+
+#include "Budget.h"
+#include "../network/DistanceMatrix.h"
+#include "../utils/Progress.h"
+
+class SimulatedAnnealing {
+/* ATTRIBUTES */
+public:
+    struct Config : Budget {
+        double initialTemperature = 0;  // 0 estimates it from the tour, so that about half the worse moves are accepted
+        double coolingRate = 0.995;     // the temperature is multiplied by this after each epoch
+        double finalTemperature = 1e-4; // relative to the initial temperature
+        int movesPerEpoch = 0;          // 0 uses 10 * |V|
+
+        Config() : Budget(5) {}
+    };
+
+private:
+    const DistanceMatrix &matrix;
+    Config schedule;
+    Progress *progress;
+
+/* CONSTRUCTOR */
+public:
+    SimulatedAnnealing(const DistanceMatrix &matrix, const Config &schedule, Progress *progress = nullptr);
+
+/* METHODS */
+public:
+    double run(std::vector<int> &order);
+};
+
+#endif //DA_PROJ2_SIMULATEDANNEALING_H
@@ -0,0 +1,156 @@
+#include "Profiler.h"
+#include "Tracer.h"
+
+std::atomic<uint64_t> Profiler::time[PHASES];
+std::atomic<uint64_t> Profiler::calls[PHASES];
+std::atomic<uint64_t> Profiler::counts[COUNTERS];
+
+/**
+ * @brief adds the time elapsed since the Timer was created to its phase (and, if tracing is on, records it as a span)
+ */
+Profiler::Timer::~Timer() {
+    auto end = std::chrono::steady_clock::now();
+    record(phase, (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    if (Tracer::enabled()) Tracer::record(label(phase), start, end);
+}
+
+/**
+ * @brief adds up two reports (e.g. the one of loading a graph and the one of running an algorithm on it)
+ * @param rhs report to be added
+ * @return sum of the reports
+ */
+Profiler::Report Profiler::Report::operator+(const Report &rhs) const {
+    Report sum = *this;
+
+    for (int i = 0; i < PHASES; ++i) {
+        sum.time[i] += rhs.time[i];
+        sum.calls[i] += rhs.calls[i];
+    }
+
+    for (int i = 0; i < COUNTERS; ++i)
+        sum.counts[i] += rhs.counts[i];
+
+    return sum;
+}
+
+/**
+ * @brief computes what was recorded between two snapshots
+ * @param rhs earlier snapshot
+ * @return report of what was recorded since the earlier snapshot
+ */
+Profiler::Report Profiler::Report::operator-(const Report &rhs) const {
+    Report difference = *this;
+
+    for (int i = 0; i < PHASES; ++i) {
+        difference.time[i] -= rhs.time[i];
+        difference.calls[i] -= rhs.calls[i];
+    }
+
+    for (int i = 0; i < COUNTERS; ++i)
+        difference.counts[i] -= rhs.counts[i];
+
+    return difference;
+}
+
+/**
+ * @brief indicates if nothing was recorded (which is always the case when building without PROFILING)
+ * @return 'true' if the report is empty, 'false' otherwise
+ */
+bool Profiler::Report::empty() const {
+    for (int i = 0; i < PHASES; ++i)
+        if (calls[i]) return false;
+
+    for (int i = 0; i < COUNTERS; ++i)
+        if (counts[i]) return false;
+
+    return true;
+}
+
+/**
+ * @brief returns the time spent in a phase
+ * @param phase phase of the run
+ * @return time spent in the phase (in milliseconds)
+ */
+double Profiler::Report::milliseconds(Phase phase) const {
+    return (double) time[phase] / 1e6;
+}
+
+/**
+ * @brief adds the duration of a section to its phase
+ * @note safe to call concurrently
+ * @param phase phase the section belongs to
+ * @param nanoseconds duration of the section
+ */
+void Profiler::record(Phase phase, uint64_t nanoseconds) {
+    time[phase].fetch_add(nanoseconds, std::memory_order_relaxed);
+    calls[phase].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief adds to one of the counters
+ * @note safe to call concurrently
+ * @param counter counter to be incremented
+ * @param n amount to be added
+ */
+void Profiler::count(Counter counter, uint64_t n) {
+    counts[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+/**
+ * @brief takes a snapshot of everything that was recorded so far (by every thread)
+ * @return totals of every phase and counter
+ */
+Profiler::Report Profiler::snapshot() {
+    Report report = {};
+
+    for (int i = 0; i < PHASES; ++i) {
+        report.time[i] = time[i].load(std::memory_order_relaxed);
+        report.calls[i] = calls[i].load(std::memory_order_relaxed);
+    }
+
+    for (int i = 0; i < COUNTERS; ++i)
+        report.counts[i] = counts[i].load(std::memory_order_relaxed);
+
+    return report;
+}
+
+/**
+ * @brief returns the name of a phase, as written in the JSON output
+ * @param phase phase of the run
+ * @return name of the phase
+ */
+const char *Profiler::key(Phase phase) {
+    static const char *keys[] = {"load", "matrix", "mst", "nearest_neighbours", "two_opt", "output"};
+    return keys[phase];
+}
+
+/**
+ * @brief returns the name of a counter, as written in the JSON output
+ * @param counter counter
+ * @return name of the counter
+ */
+const char *Profiler::key(Counter counter) {
+    static const char *keys[] = {"edges_read", "two_opt_passes", "two_opt_moves"};
+    return keys[counter];
+}
+
+/**
+ * @brief returns the name of a phase, as shown to the user
+ * @param phase phase of the run
+ * @return name of the phase
+ */
+const char *Profiler::label(Phase phase) {
+    static const char *labels[] = {"Load", "Distance matrix", "MST", "Nearest-Neighbours", "2-opt", "Output"};
+    return labels[phase];
+}
+
+/**
+ * @brief returns the name of a counter, as shown to the user
+ * @param counter counter
+ * @return name of the counter
+ */
+const char *Profiler::label(Counter counter) {
+    static const char *labels[] = {"Edges read", "2-opt passes", "2-opt moves"};
+    return labels[counter];
+}
@@ -0,0 +1,78 @@
+#ifndef DA_PROJ2_PROFILER_H
+#define DA_PROJ2_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/*
+ * instrumentation of the hot paths: scoped timers and counters that accumulate into process-wide totals, from which
+ * the breakdown of a run is obtained as the difference between two snapshots; building without PROFILING (e.g.
+ * 'cmake -DPROFILING=OFF') removes every PROFILE_* statement, so that the instrumentation costs nothing at all
+ */
+
+class Profiler {
+/* ATTRIBUTES */
+public:
+    enum Phase {LOAD, MATRIX, MST, NEAREST_NEIGHBOURS, TWO_OPT, OUTPUT, PHASES};
+    enum Counter {EDGES_READ, TWO_OPT_PASSES, TWO_OPT_MOVES, COUNTERS};
+
+#ifdef PROFILING
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    struct Report {
+        uint64_t time[PHASES];      // in nanoseconds
+        uint64_t calls[PHASES];
+        uint64_t counts[COUNTERS];
+
+        Report operator+(const Report &rhs) const;
+        Report operator-(const Report &rhs) const;
+        bool empty() const;
+        double milliseconds(Phase phase) const;
+    };
+
+    class Timer {
+    private:
+        Phase phase;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit Timer(Phase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+        ~Timer();
+
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+    };
+
+private:
+    static std::atomic<uint64_t> time[PHASES], calls[PHASES], counts[COUNTERS];
+
+/* METHODS */
+public:
+    static void record(Phase phase, uint64_t nanoseconds);
+    static void count(Counter counter, uint64_t n);
+    static Report snapshot();
+
+    static const char *key(Phase phase);
+    static const char *key(Counter counter);
+    static const char *label(Phase phase);
+    static const char *label(Counter counter);
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef PROFILING
+// times the rest of the enclosing scope, e.g. PROFILE_SCOPE(MST)
+#define PROFILE_SCOPE(phase) Profiler::Timer PROFILE_CONCAT(profileTimer_, __LINE__)(Profiler::phase)
+// adds to one of the counters, e.g. PROFILE_COUNT(TWO_OPT_MOVES, 1)
+#define PROFILE_COUNT(counter, n) Profiler::count(Profiler::counter, (uint64_t) (n))
+#else
+#define PROFILE_SCOPE(phase) ((void) 0)
+#define PROFILE_COUNT(counter, n) ((void) 0)
+#endif
+
+#endif //DA_PROJ2_PROFILER_H
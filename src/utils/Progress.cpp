@@ -0,0 +1,128 @@
+#include <limits>
+
+#include "Progress.h"
+
+/**
+ * @brief computes the relative difference between the best tour and the lower bound
+ * @return optimality gap (e.g. 0.05 means that the best tour is at most 5% longer than the optimal one), or infinity
+ * if either the best tour or the bound is unknown
+ */
+double Progress::Snapshot::gap() const {
+    if (bound <= 0 || best == std::numeric_limits<double>::infinity())
+        return std::numeric_limits<double>::infinity();
+
+    return (best - bound) / bound;
+}
+
+/**
+ * @brief creates a new Progress, the channel through which a running solver reports its best tour and is cancelled
+ */
+Progress::Progress()
+    : cancelled(false), best(std::numeric_limits<double>::infinity()), bound(0), iterations(0), nodes(0),
+      start(std::chrono::steady_clock::now()), deadline(start), hasDeadline(false) {}
+
+/**
+ * @brief asks the solver to stop as soon as possible (returning the best tour it has found so far)
+ */
+void Progress::cancel() {
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief sets a time limit, after which the solver is cancelled
+ * @note must be called before the solver starts
+ * @param timeLimit time limit, counted from the creation of the Progress (in seconds)
+ */
+void Progress::setDeadline(double timeLimit) {
+    deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(timeLimit));
+    hasDeadline = true;
+}
+
+/**
+ * @brief indicates if the solver was asked to stop, either explicitly or because its time limit ran out
+ * @return 'true' if the solver was cancelled, 'false' otherwise
+ */
+bool Progress::isCancelled() const {
+    return cancelled.load(std::memory_order_relaxed) || (hasDeadline && std::chrono::steady_clock::now() >= deadline);
+}
+
+/**
+ * @brief reports the length of a tour found by the solver, which becomes the best one if it is shorter
+ * @param length length of the tour
+ */
+void Progress::improve(double length) {
+    double curr = best.load(std::memory_order_relaxed);
+    while (length < curr && !best.compare_exchange_weak(curr, length, std::memory_order_relaxed));
+}
+
+/**
+ * @brief reports a lower bound on the length of the optimal tour, which replaces the current one if it is tighter
+ * @param length lower bound
+ */
+void Progress::setBound(double length) {
+    double curr = bound.load(std::memory_order_relaxed);
+    while (length > curr && !bound.compare_exchange_weak(curr, length, std::memory_order_relaxed));
+}
+
+/**
+ * @brief reports the work done by the solver since its last report
+ * @param iterations number of iterations done
+ * @param nodes number of nodes of the search tree explored
+ */
+void Progress::advance(long long iterations, long long nodes) {
+    this->iterations.fetch_add(iterations, std::memory_order_relaxed);
+    this->nodes.fetch_add(nodes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief returns the length of the best tour reported so far
+ * @return length of the best tour (infinity if none was reported)
+ */
+double Progress::getBest() const {
+    return best.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief returns the current state of the solver
+ * @return Snapshot with the work done, the best tour, the lower bound and the elapsed time
+ */
+Progress::Snapshot Progress::snapshot() const {
+    Snapshot res{};
+
+    res.iterations = iterations.load(std::memory_order_relaxed);
+    res.nodes = nodes.load(std::memory_order_relaxed);
+    res.best = best.load(std::memory_order_relaxed);
+    res.bound = bound.load(std::memory_order_relaxed);
+    res.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return res;
+}
+
+/**
+ * @brief indicates if the solver was asked to stop
+ * @param progress Progress of the solver (may be nullptr)
+ * @return 'true' if the solver was cancelled, 'false' otherwise
+ */
+bool Progress::isCancelled(const Progress *progress) {
+    return progress && progress->isCancelled();
+}
+
+/**
+ * @brief reports the length of a tour found by the solver
+ * @param progress Progress of the solver (may be nullptr)
+ * @param length length of the tour
+ */
+void Progress::improve(Progress *progress, double length) {
+    if (progress) progress->improve(length);
+}
+
+/**
+ * @brief reports the work done by the solver since its last report
+ * @param progress Progress of the solver (may be nullptr)
+ * @param iterations number of iterations done
+ * @param nodes number of nodes of the search tree explored
+ */
+void Progress::advance(Progress *progress, long long iterations, long long nodes) {
+    if (progress) progress->advance(iterations, nodes);
+}
@@ -0,0 +1,48 @@
+#ifndef DA_PROJ2_PROGRESS_H
+#define DA_PROJ2_PROGRESS_H
+
+#include <atomic>
+#include <chrono>
+
+class Progress {
+/* ATTRIBUTES */
+public:
+    struct Snapshot {
+        long long iterations;   // meaning depends on the solver (e.g. moves, kicks, generations)
+        long long nodes;        // nodes of the search tree explored (by exact solvers)
+        double best;            // length of the best tour found (infinity if none)
+        double bound;           // lower bound on the length of the optimal tour (0 if unknown)
+        double elapsed;         // in seconds
+
+        double gap() const;
+    };
+
+private:
+    std::atomic<bool> cancelled;
+    std::atomic<double> best, bound;
+    std::atomic<long long> iterations, nodes;
+
+    std::chrono::steady_clock::time_point start, deadline;
+    bool hasDeadline;
+
+/* CONSTRUCTOR */
+public:
+    Progress();
+
+/* METHODS */
+public:
+    void cancel();
+    void setDeadline(double timeLimit);
+    bool isCancelled() const;
+    void improve(double length);
+    void setBound(double length);
+    void advance(long long iterations, long long nodes = 0);
+    double getBest() const;
+    Snapshot snapshot() const;
+
+    static bool isCancelled(const Progress *progress);
+    static void improve(Progress *progress, double length);
+    static void advance(Progress *progress, long long iterations, long long nodes = 0);
+};
+
+#endif //DA_PROJ2_PROGRESS_H
@@ -0,0 +1,68 @@
+#ifndef DA_PROJ2_RANDOM_HPP
+#define DA_PROJ2_RANDOM_HPP
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+
+class XorShift {
+/* ATTRIBUTES */
+private:
+    uint64_t state;
+
+/* CONSTRUCTOR */
+public:
+    /**
+     * @brief creates a new xorshift64* generator
+     * @param seed seed of the generator (0 picks a random one)
+     */
+    explicit XorShift(uint64_t seed = 0) : state(seed) {
+        if (!state) state = ((uint64_t) std::random_device()() << 32) ^ std::random_device()();
+        if (!state) state = 0x9E3779B97F4A7C15ULL;
+    }
+
+/* METHODS */
+public:
+    /**
+     * @brief returns the generator of the calling thread
+     * @return reference to the generator of the calling thread
+     */
+    static XorShift &local() {
+        thread_local XorShift rng(std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+                                  ((uint64_t) std::random_device()() << 32));
+        return rng;
+    }
+
+    /**
+     * @brief generates the next pseudo-random number
+     * @complexity O(1)
+     * @return pseudo-random 64-bit number
+     */
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    /**
+     * @brief generates a pseudo-random integer in the range [0, bound[
+     * @param bound upper bound (exclusive) of the range
+     * @return pseudo-random integer
+     */
+    int nextInt(int bound) {
+        return (int) ((next() >> 32) * (uint64_t) bound >> 32);
+    }
+
+    /**
+     * @brief generates a pseudo-random real number in the range [0, 1[
+     * @return pseudo-random real number
+     */
+    double nextDouble() {
+        return (double) (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+#endif //DA_PROJ2_RANDOM_HPP
@@ -1,4 +1,13 @@
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include "Profiler.h"
 #include "Reader.h"
+#include "Tracer.h"
+
+// number of edges read from a binary file at once
+#define EDGE_CHUNK (1 << 16)
 
 /**
  * @brief creates a Reader object
@@ -7,6 +16,8 @@
  */
 Reader::Reader(char valueDelim, char lineDelim) : valueDelim(valueDelim), lineDelim(lineDelim) {}
 
+string Reader::matrixCache;
+
 /**
  * @brief extracts the next value of a CSV line
  * @complexity 0(n)
@@ -33,14 +44,19 @@ void Reader::extractValue(std::string::iterator& lineIt, std::string& value, cha
 /**
  * @brief reads the file which contains information about the vertices of the graph
  * @param graph undirected graph that will be modelled based on the read information
+ * @param path path to the file
+ * @param hasHeader indicates if the first line of the file is a header
+ * @param checksum hash that will be updated with every line of the file (nullptr if it is not needed)
  */
-void Reader::readVertices(TSPGraph &graph, const string &path, bool hasHeader) {
+void Reader::readVertices(TSPGraph &graph, const string &path, bool hasHeader, uint64_t *checksum) {
+    TRACE_SCOPE("parse nodes");
     reader.open(path);
 
     string line;
     if (hasHeader) getline(reader, line); // header
 
     while (getline(reader, line)){
+        if (checksum) *checksum = Utils::hash(line.c_str(), line.size() + 1, *checksum);
         auto it = line.begin();
 
         // read the id (will be ignored)
@@ -65,14 +81,19 @@ void Reader::readVertices(TSPGraph &graph, const string &path, bool hasHeader) {
 /**
  * @brief reads the file which contains information about the edges of the graph
  * @param graph undirected graph that will be modelled based on the read information
+ * @param path path to the file
+ * @param hasHeader indicates if the first line of the file is a header
+ * @param checksum hash that will be updated with every line of the file (nullptr if it is not needed)
  */
-void Reader::readEdges(TSPGraph &graph, const string &path, bool hasHeader) {
+void Reader::readEdges(TSPGraph &graph, const string &path, bool hasHeader, uint64_t *checksum) {
+    TRACE_SCOPE("parse edges");
     reader.open(path);
 
     string line;
     if (hasHeader) getline(reader, line); // header
 
     while (getline(reader, line)){
+        if (checksum) *checksum = Utils::hash(line.c_str(), line.size() + 1, *checksum);
         auto it = line.begin();
 
         // read the origin
@@ -92,20 +113,76 @@ void Reader::readEdges(TSPGraph &graph, const string &path, bool hasHeader) {
 
         graph.resize(std::max(src, dest));
         graph.addEdge(src, dest, stod(distance));
+
+        PROFILE_COUNT(EDGES_READ, 1);
     }
 
     reader.close();
     reader.clear();
 }
 
+/**
+ * @brief reads a binary graph file (see BinaryHeader), which is much faster to load than the CSV files
+ * @param path path to the file
+ * @return undirected graph modelled after the file
+ * @throws std::runtime_error if the file cannot be read or is not a valid binary graph
+ */
+TSPGraph Reader::readBinary(const string &path) {
+    std::ifstream file(path, std::ios::binary);
+
+    BinaryHeader header = {};
+    file.read((char *) &header, sizeof(header));
+
+    if (!file || memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) != 0 || header.vertices > INT32_MAX)
+        throw std::runtime_error("invalid binary graph: " + path);
+
+    int n = (int) header.vertices;
+    TSPGraph graph(header.hasCoordinates != 0);
+
+    if (header.hasCoordinates) {
+        std::vector<double> coordinates(2 * (size_t) n);
+        file.read((char *) coordinates.data(), (std::streamsize) (coordinates.size() * sizeof(double)));
+
+        for (int i = 0; i < n; ++i)
+            graph.addVertex(new Place(coordinates[2 * i], coordinates[2 * i + 1]));
+    }
+    else graph.resize(n);
+
+    std::vector<BinaryEdge> chunk(EDGE_CHUNK);
+
+    for (uint64_t left = header.edges; left && file;) {
+        TRACE_SCOPE("parse chunk", (long long) ((header.edges - left) / EDGE_CHUNK));
+        auto count = (size_t) std::min<uint64_t>(left, EDGE_CHUNK);
+        file.read((char *) chunk.data(), (std::streamsize) (count * sizeof(BinaryEdge)));
+
+        for (size_t i = 0; i < count && file; ++i) {
+            const BinaryEdge &e = chunk[i];
+
+            if (e.src < 0 || e.dest < 0 || e.src >= n || e.dest >= n)
+                throw std::runtime_error("invalid edge in binary graph: " + path);
+
+            graph.addEdge(e.src + 1, e.dest + 1, e.weight);
+        }
+
+        PROFILE_COUNT(EDGES_READ, count);
+        left -= count;
+    }
+
+    if (!file) throw std::runtime_error("truncated binary graph: " + path);
+    return graph;
+}
+
 /**
  * @brief reads a file which represents a graph
- * @param path path to the file/directory where the data files are
+ * @param path path to the file/directory where the data files are (or to a binary graph, ending in .bin)
  * @param twoFiles
  * @param hasHeader
  * @return undirected graph modelled after the file
  */
 TSPGraph Reader::read(const string &path, bool hasHeader) {
+    PROFILE_SCOPE(LOAD);
+    if (path.size() > 4 && path.substr(path.size() - 4, 4) == ".bin") return readBinary(path);
+
     bool oneFile = (path.substr(path.size() - 4, 4) == ".csv");
     TSPGraph graph(!oneFile); // if it has two files, it is one of the Real-Graphs
 
@@ -115,11 +192,52 @@ TSPGraph Reader::read(const string &path, bool hasHeader) {
     }
 
     std::string path_ = (path.back() == '/') ? path : path + '/';
+    uint64_t checksum = Utils::hash(&hasHeader, sizeof(hasHeader));
 
-    readVertices(graph, path_ + "nodes.csv", hasHeader);
-    readEdges(graph, path_ + "edges.csv", hasHeader);
+    readVertices(graph, path_ + "nodes.csv", hasHeader, &checksum);
+    readEdges(graph, path_ + "edges.csv", hasHeader, &checksum);
+
+    // the distances of the Real-Graphs take O(|V|^2) haversine computations, so they may be kept in the cache
+    // directory, under the checksum of their files (which is also checked against the one stored in the file)
+    if (!matrixCache.empty()) {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.matrix", (unsigned long long) checksum);
+
+        graph.setMatrixCache(matrixCache + '/' + name, checksum);
+    }
 
     return graph;
 }
 
+/**
+ * @brief sets the directory where the distance matrices of the two-file graphs are persisted, so that later runs read
+ * them instead of computing them (they are not persisted unless it is set)
+ * @note only affects the graphs that are read afterwards
+ * @param directory path to the directory, which must exist
+ */
+void Reader::setMatrixCache(const string &directory) {
+    matrixCache = directory;
+}
+
+/**
+ * @brief detects if the files of a graph have a header, which is the case if the first value of the edge file is not
+ * a number (as the first value of every other line is the index of a vertex)
+ * @param path path to the file/directory where the data files are (or to a binary graph, ending in .bin)
+ * @return 'true' if the files have a header, 'false' otherwise (including if the file cannot be read)
+ */
+bool Reader::detectHeader(const string &path) {
+    if (path.size() > 4 && path.substr(path.size() - 4, 4) == ".bin") return false;
+
+    bool oneFile = (path.size() > 4 && path.substr(path.size() - 4, 4) == ".csv");
+    std::ifstream file(oneFile ? path : path + (path.back() == '/' ? "" : "/") + "edges.csv");
 
+    string line;
+    if (!getline(file, line) || line.empty()) return false;
+
+    auto it = line.begin();
+    string value;
+    extractValue(it, value, ',');
+
+    double _;
+    return !Utils::toDouble(value, _);
+}
@@ -1,11 +1,34 @@
 #ifndef DA_PROJ2_READER_H
 #define DA_PROJ2_READER_H
 
+#include <cstdint>
+
 #include "Utils.hpp"
 #include "../network/TSPGraph.h"
 
+// identifies the binary graph files (the last character is the version of the format)
+#define BINARY_MAGIC "DAP2GRF1"
+
 using std::string;
 
+/*
+ * layout of a binary graph file: this header, followed by the latitude and longitude of each vertex (as two doubles,
+ * only if the graph has coordinates) and by the source, destination (as two int32_t, starting at 0) and weight (as a
+ * double) of each edge, all in the native byte order
+ */
+struct BinaryHeader {
+    char magic[8];
+    uint32_t hasCoordinates;
+    uint32_t reserved;
+    uint64_t vertices;
+    uint64_t edges;
+};
+
+struct BinaryEdge {
+    int32_t src, dest;
+    double weight;
+};
+
 class Reader {
 /* ATTRIBUTES */
 private:
@@ -13,17 +36,22 @@ private:
     std::ifstream reader;
     char valueDelim, lineDelim; // delimiters
 
+    static string matrixCache;  // directory where the distance matrices are persisted (empty if they are not)
+
 /* CONSTRUCTOR */
 public:
     explicit Reader(char valueDelim = ',', char lineDelim = '\n');
 
 /* METHODS */
 private:
-    static void extractValue(std::string::iterator& lineIt, std::string& value, char delim);
-    void readVertices(TSPGraph &g, const string &path, bool hasHeader);
-    void readEdges(TSPGraph &g, const string &path, bool hasHeader);
+    void readVertices(TSPGraph &g, const string &path, bool hasHeader, uint64_t *checksum = nullptr);
+    void readEdges(TSPGraph &g, const string &path, bool hasHeader, uint64_t *checksum = nullptr);
+    TSPGraph readBinary(const string &path);
 
 public:
+    static void extractValue(std::string::iterator& lineIt, std::string& value, char delim);
+    static void setMatrixCache(const string &directory);
+    static bool detectHeader(const string &path);
     TSPGraph read(const string &path, bool hasHeader);
 };
 
@@ -0,0 +1,360 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <unistd.h>
+
+#include "ResultWriter.h"
+
+// size of the buffer, which is written out whenever it fills up
+#define BUFFER_SIZE (1 << 16)
+
+/**
+ * @brief creates a new ResultWriter, which streams the results of the TSP algorithms to a file descriptor, using
+ * buffered writes
+ * @param fd file descriptor where the results will be written (it is not closed by the ResultWriter)
+ * @param format format of the output (CSV, with one line per result, or JSON Lines, with one object per line)
+ * @param tours indicates if the tour of each result should also be written
+ */
+ResultWriter::ResultWriter(int fd, Format format, bool tours)
+    : fd(fd), target(nullptr), format(format), tours(tours), buffer(BUFFER_SIZE), used(0),
+      failed(false) {}
+
+/**
+ * @brief creates a new ResultWriter, which appends the results of the TSP algorithms to a string
+ * @param target string where the results will be appended
+ * @param format format of the output (CSV, with one line per result, or JSON Lines, with one object per line)
+ * @param tours indicates if the tour of each result should also be written
+ */
+ResultWriter::ResultWriter(std::string &target, Format format, bool tours)
+    : fd(-1), target(&target), format(format), tours(tours), buffer(BUFFER_SIZE), used(0),
+      failed(false) {}
+
+/**
+ * @brief writes out whatever is left in the buffer
+ * @note a destructor cannot report an error, so the owner should call flush() (or good()) before it
+ */
+ResultWriter::~ResultWriter() {
+    flush();
+}
+
+/**
+ * @brief appends a character to the buffer
+ * @param c character to be appended
+ */
+void ResultWriter::put(char c) {
+    if (used == buffer.size()) flush();
+    buffer[used++] = c;
+}
+
+/**
+ * @brief appends a null-terminated sequence of characters to the buffer
+ * @param s pointer to the first character
+ */
+void ResultWriter::put(const char *s) {
+    put(s, strlen(s));
+}
+
+/**
+ * @brief appends a sequence of characters to the buffer
+ * @param s pointer to the first character
+ * @param size number of characters
+ */
+void ResultWriter::put(const char *s, size_t size) {
+    while (size) {
+        if (used == buffer.size()) flush();
+
+        size_t count = std::min(size, buffer.size() - used);
+        memcpy(buffer.data() + used, s, count);
+
+        used += count;
+        s += count;
+        size -= count;
+    }
+}
+
+/**
+ * @brief appends a string to the buffer
+ * @param s string to be appended
+ */
+void ResultWriter::put(const std::string &s) {
+    put(s.data(), s.size());
+}
+
+/**
+ * @brief appends an integer to the buffer, without going through a stream
+ * @param n integer to be appended
+ */
+void ResultWriter::putInteger(long long n) {
+    char digits[24];
+    int size = 0;
+
+    unsigned long long value = (n < 0) ? 0ULL - (unsigned long long) n : (unsigned long long) n;
+
+    do {
+        digits[size++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    if (n < 0) put('-');
+    while (size) put(digits[--size]);
+}
+
+/**
+ * @brief appends a number to the buffer, with two decimal places
+ * @note a number that is not finite (or that stands for a missing edge, i.e. INF) has no valid representation, so it
+ * is written as null in JSON and left empty in CSV
+ * @param d number to be appended
+ */
+void ResultWriter::putNumber(double d) {
+    if (!std::isfinite(d) || std::fabs(d) >= std::numeric_limits<double>::max()) {
+        if (format == JSON) put("null");
+        return;
+    }
+
+    char s[64];
+    int size = snprintf(s, sizeof(s), "%.2f", d);
+
+    put(s, (size_t) std::max(0, std::min(size, (int) sizeof(s) - 1)));
+}
+
+/**
+ * @brief appends a quoted string to the buffer, escaping it according to the format
+ * @param s string to be appended
+ */
+void ResultWriter::putString(const std::string &s) {
+    put(quote(s, format));
+}
+
+/**
+ * @brief appends the vertices of a tour to the buffer (as shown to the user, i.e. starting at 0)
+ * @param tour tour to be appended
+ * @param separator character written between each pair of vertices
+ */
+void ResultWriter::putTour(const Tour &tour, char separator) {
+    for (int i = 0; i < tour.size(); ++i) {
+        if (i) put(separator);
+        putInteger(tour[i] - 1);
+    }
+}
+
+/**
+ * @brief appends the breakdown of a run to the buffer, as a JSON object with the time of each phase (in milliseconds)
+ * and the value of each counter
+ * @param profile breakdown of the run
+ */
+void ResultWriter::putProfile(const Profiler::Report &profile) {
+    put('{');
+
+    for (int i = 0; i < Profiler::PHASES; ++i) {
+        auto phase = (Profiler::Phase) i;
+
+        if (i) put(',');
+        put('"');
+        put(Profiler::key(phase));
+        put("_ms\":");
+        putNumber(profile.milliseconds(phase));
+    }
+
+    for (int i = 0; i < Profiler::COUNTERS; ++i) {
+        put(",\"");
+        put(Profiler::key((Profiler::Counter) i));
+        put("\":");
+        putInteger((long long) profile.counts[i]);
+    }
+
+    put('}');
+}
+
+/**
+ * @brief converts the name of a format into a Format
+ * @param name name of the format ("csv" or "json")
+ * @param format Format where the result will be stored
+ * @return 'true' if the name is valid, 'false' otherwise
+ */
+bool ResultWriter::parseFormat(const std::string &name, Format &format) {
+    if (name == "csv") format = CSV;
+    else if (name == "json") format = JSON;
+    else return false;
+
+    return true;
+}
+
+/**
+ * @brief quotes a string, escaping it according to the format (in JSON, the control characters are written as \u
+ * escapes, rather than dropped, so that the string is kept intact)
+ * @param s string to be quoted
+ * @param format format the string will be written in
+ * @return quoted and escaped string
+ */
+std::string ResultWriter::quote(const std::string &s, Format format) {
+    std::string res = "\"";
+
+    for (char c : s) {
+        if (format == CSV) {
+            if (c == '"') res += '"';
+            res += c;
+
+            continue;
+        }
+
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        }
+        else if ((unsigned char) c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+
+            res.append(escaped, 6);
+        }
+        else res += c;
+    }
+
+    return res + '"';
+}
+
+/**
+ * @brief writes the header of the output (only CSV has one)
+ */
+void ResultWriter::writeHeader() {
+    if (format != CSV) return;
+
+    put("graph,algorithm,source,vertices,length,lower_bound,gap_percent,time_ms,load_ms,status");
+    if (tours) put(",tour");
+
+    put('\n');
+}
+
+/**
+ * @brief writes a result, streaming its tour straight into the buffer (leaving the unknown values empty or null)
+ * @param record result to be written
+ */
+void ResultWriter::write(const Record &record) {
+    bool hasGap = (record.length > 0 && record.bound > 0);
+    double gap = hasGap ? 100 * (record.length - record.bound) / record.bound : 0;
+
+    if (format == CSV) {
+        putString(record.graph);
+        put(',');
+        put(record.algorithm);
+        put(',');
+        putInteger(record.source);
+        put(',');
+        putInteger(record.vertices);
+        put(',');
+        if (record.length > 0) putNumber(record.length);
+        put(',');
+        if (record.bound > 0) putNumber(record.bound);
+        put(',');
+        if (hasGap) putNumber(gap);
+        put(',');
+        putInteger(record.time);
+        put(',');
+        putInteger(record.load);
+        put(',');
+        put(record.status);
+
+        if (tours) {
+            put(',');
+            if (record.tour) putTour(*record.tour, ' ');
+        }
+
+        put('\n');
+        return;
+    }
+
+    put("{\"graph\":");
+    putString(record.graph);
+    put(",\"algorithm\":");
+    putString(record.algorithm);
+    put(",\"source\":");
+    putInteger(record.source);
+    put(",\"vertices\":");
+    putInteger(record.vertices);
+
+    put(",\"length\":");
+    if (record.length > 0) putNumber(record.length);
+    else put("null");
+
+    put(",\"lower_bound\":");
+    if (record.bound > 0) putNumber(record.bound);
+    else put("null");
+
+    put(",\"gap_percent\":");
+    if (hasGap) putNumber(gap);
+    else put("null");
+
+    put(",\"time_ms\":");
+    putInteger(record.time);
+    put(",\"load_ms\":");
+    putInteger(record.load);
+    put(",\"status\":");
+    putString(record.status);
+
+    if (tours) {
+        put(",\"tour\":[");
+        if (record.tour) putTour(*record.tour, ',');
+        put(']');
+    }
+
+    if (record.profile) {
+        put(",\"profile\":");
+        putProfile(*record.profile);
+    }
+
+    put("}\n");
+}
+
+/**
+ * @brief writes results that were already formatted by another ResultWriter (with the same format, and into a string)
+ * @param results text of the results
+ */
+void ResultWriter::append(const std::string &results) {
+    put(results);
+}
+
+/**
+ * @brief writes out the contents of the buffer
+ * @note once a write fails, the output is incomplete, so the error is kept (and the rest of the output is discarded)
+ * @return 'true' if everything written so far (including by the flushes of a full buffer) reached the file
+ * descriptor, 'false' otherwise
+ */
+bool ResultWriter::flush() {
+    const char *data = buffer.data();
+    size_t size = used;
+
+    used = 0;
+    if (failed) return false;
+
+    if (target) {
+        target->append(data, size);
+        return true;
+    }
+
+    while (size) {
+        ssize_t written = ::write(fd, data, size);
+
+        if (written < 0) {
+            if (errno == EINTR) continue;
+
+            failed = true;
+            return false;
+        }
+
+        data += written;
+        size -= (size_t) written;
+    }
+
+    return true;
+}
+
+/**
+ * @brief indicates if every write so far has succeeded
+ * @return 'true' if no write has failed, 'false' otherwise
+ */
+bool ResultWriter::good() const {
+    return !failed;
+}
@@ -0,0 +1,68 @@
+#ifndef DA_PROJ2_RESULTWRITER_H
+#define DA_PROJ2_RESULTWRITER_H
+
+#include <string>
+#include <vector>
+
+#include "Profiler.h"
+#include "../network/Tour.h"
+
+class ResultWriter {
+/* ATTRIBUTES */
+public:
+    enum Format {CSV, JSON};
+
+    struct Record {
+        std::string graph, algorithm, status;
+        int source;             // index of the source vertex (as shown to the user, i.e. starting at 0)
+        int vertices;
+        double length;          // 0 if no tour was found
+        double bound;           // 0 if unknown
+        long long time, load;   // in milliseconds
+        const Tour *tour;       // nullptr if the tour should not be written
+        const Profiler::Report *profile;    // nullptr if the breakdown should not be written (only JSON has it)
+    };
+
+private:
+    int fd;                     // -1 if the output is written to a string
+    std::string *target;
+    Format format;
+    bool tours;
+
+    std::vector<char> buffer;
+    size_t used;
+    bool failed;                // indicates if a write has failed (which is kept, so that every later flush reports it)
+
+/* CONSTRUCTOR */
+public:
+    ResultWriter(int fd, Format format, bool tours);
+    ResultWriter(std::string &target, Format format, bool tours);
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter &) = delete;
+    ResultWriter &operator=(const ResultWriter &) = delete;
+
+/* METHODS */
+private:
+    void put(char c);
+    void put(const char *s);
+    void put(const char *s, size_t size);
+    void put(const std::string &s);
+    void putInteger(long long n);
+    void putNumber(double d);
+    void putString(const std::string &s);
+    void putTour(const Tour &tour, char separator);
+    void putProfile(const Profiler::Report &profile);
+
+public:
+    static bool parseFormat(const std::string &name, Format &format);
+    static std::string quote(const std::string &s, Format format);
+
+    void writeHeader();
+    void write(const Record &record);
+    void append(const std::string &results);
+    bool flush();
+    bool good() const;
+};
+
+#endif //DA_PROJ2_RESULTWRITER_H
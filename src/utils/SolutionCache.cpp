@@ -0,0 +1,78 @@
+#include "SolutionCache.h"
+
+/**
+ * @brief creates a new SolutionCache, which remembers the tours computed by the TSP algorithms, so that repeated
+ * requests can be answered without running them again
+ * @param capacity maximum number of tours kept (the least recently used one is evicted first)
+ */
+SolutionCache::SolutionCache(size_t capacity) : capacity(capacity ? capacity : 1) {}
+
+/**
+ * @brief returns the cache shared by the whole program
+ * @return reference to the shared SolutionCache
+ */
+SolutionCache &SolutionCache::shared() {
+    static SolutionCache cache;
+    return cache;
+}
+
+/**
+ * @brief looks up the tour computed by an algorithm on a graph
+ * @complexity O(log(N) + |V|), where N is the number of cached tours
+ * @param fingerprint fingerprint of the graph
+ * @param algorithm name of the algorithm
+ * @param timeLimit time limit the algorithm was given (0 for its default)
+ * @param entry Entry where the tour will be copied to
+ * @return 'true' if the tour was found, 'false' otherwise
+ */
+bool SolutionCache::find(uint64_t fingerprint, const std::string &algorithm, double timeLimit, Entry &entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(Key(fingerprint, algorithm, timeLimit));
+    if (it == index.end()) return false;
+
+    entries.splice(entries.begin(), entries, it->second);
+    entry = it->second->second;
+
+    return true;
+}
+
+/**
+ * @brief stores the tour computed by an algorithm on a graph, replacing the previous one (if any)
+ * @complexity O(log(N)), where N is the number of cached tours
+ * @param fingerprint fingerprint of the graph
+ * @param algorithm name of the algorithm
+ * @param timeLimit time limit the algorithm was given (0 for its default)
+ * @param entry tour to be stored
+ */
+void SolutionCache::store(uint64_t fingerprint, const std::string &algorithm, double timeLimit, Entry entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Key key(fingerprint, algorithm, timeLimit);
+    auto it = index.find(key);
+
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        it->second->second = std::move(entry);
+
+        return;
+    }
+
+    if (entries.size() == capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+
+    entries.emplace_front(key, std::move(entry));
+    index[key] = entries.begin();
+}
+
+/**
+ * @brief removes every tour from the cache
+ */
+void SolutionCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    entries.clear();
+    index.clear();
+}
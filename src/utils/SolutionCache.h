@@ -0,0 +1,46 @@
+#ifndef DA_PROJ2_SOLUTIONCACHE_H
+#define DA_PROJ2_SOLUTIONCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class SolutionCache {
+/* ATTRIBUTES */
+public:
+    struct Entry {
+        std::vector<int> cycle;     // vertices in the order they are visited (any of them can be the source)
+        double length;
+        double bound;               // lower bound known when the tour was computed (0 if unknown)
+    };
+
+private:
+    // fingerprint of the graph, algorithm and time limit
+    typedef std::tuple<uint64_t, std::string, double> Key;
+
+    size_t capacity;
+    std::list<std::pair<Key, Entry>> entries;   // the most recently used entries come first
+    std::map<Key, std::list<std::pair<Key, Entry>>::iterator> index;
+    std::mutex mutex;
+
+/* CONSTRUCTOR */
+public:
+    explicit SolutionCache(size_t capacity = 64);
+
+    SolutionCache(const SolutionCache &) = delete;
+    SolutionCache &operator=(const SolutionCache &) = delete;
+
+/* METHODS */
+public:
+    static SolutionCache &shared();
+
+    bool find(uint64_t fingerprint, const std::string &algorithm, double timeLimit, Entry &entry);
+    void store(uint64_t fingerprint, const std::string &algorithm, double timeLimit, Entry entry);
+    void clear();
+};
+
+#endif //DA_PROJ2_SOLUTIONCACHE_H
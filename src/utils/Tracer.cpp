@@ -0,0 +1,162 @@
+#include <cstdio>
+#include <unistd.h>
+
+#include "Tracer.h"
+
+std::atomic<Tracer::Buffer *> Tracer::buffers(nullptr);
+std::atomic<int> Tracer::threads(0);
+std::atomic<bool> Tracer::tracing(false);
+Tracer::Clock::time_point Tracer::origin;
+
+/**
+ * @brief returns the name of the calling thread, as shown in the trace
+ * @return reference to the name of the calling thread (empty if it was not named)
+ */
+std::string &Tracer::threadName() {
+    thread_local std::string name;
+    return name;
+}
+
+/**
+ * @brief returns the buffer of the calling thread, taking it on the first call (by reusing the buffer of a thread that
+ * has exited, if there is one, or by creating a new one) and releasing it once the thread exits
+ * @note lock-free, as the buffers are only ever added to the list (and never freed)
+ * @return pointer to the buffer of the calling thread
+ */
+Tracer::Buffer *Tracer::local() {
+    struct Owner {
+        Buffer *buffer = nullptr;
+
+        ~Owner() {
+            if (buffer) buffer->owned.store(false, std::memory_order_release);
+        }
+    };
+
+    thread_local Owner owner;
+    if (owner.buffer) return owner.buffer;
+
+    for (Buffer *buffer = buffers.load(std::memory_order_acquire); buffer && !owner.buffer; buffer = buffer->next) {
+        bool expected = false;
+        if (buffer->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) owner.buffer = buffer;
+    }
+
+    if (!owner.buffer) {
+        auto buffer = new Buffer();
+        buffer->owned.store(true, std::memory_order_relaxed);
+        buffer->head.store(0, std::memory_order_relaxed);
+        buffer->id = threads.fetch_add(1, std::memory_order_relaxed) + 1;
+        buffer->next = buffers.load(std::memory_order_relaxed);
+
+        while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release,
+                                              std::memory_order_relaxed));
+
+        owner.buffer = buffer;
+    }
+
+    const std::string &name = threadName();
+
+    if (name.empty()) snprintf(owner.buffer->name, sizeof(owner.buffer->name), "thread %d", owner.buffer->id);
+    else snprintf(owner.buffer->name, sizeof(owner.buffer->name), "%s", name.c_str());
+
+    return owner.buffer;
+}
+
+/**
+ * @brief starts recording the spans of every thread, discarding the ones recorded before
+ * @note must be called while no spans are being recorded (e.g. before the runs start), and names the calling thread
+ * "main", unless it already has a name
+ */
+void Tracer::start() {
+    if (threadName().empty()) nameThread("main");
+
+    for (Buffer *buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+        buffer->head.store(0, std::memory_order_relaxed);
+
+    origin = Clock::now();
+    tracing.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief stops recording the spans (the ones recorded so far are kept, until the tracing is started again)
+ */
+void Tracer::stop() {
+    tracing.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief names the calling thread, as shown in the trace
+ * @note must be called before the thread records its first span
+ * @param name name of the thread (e.g. "worker 3")
+ */
+void Tracer::nameThread(const std::string &name) {
+    threadName() = name;
+}
+
+/**
+ * @brief records a span into the buffer of the calling thread, overwriting its oldest span if the buffer is full
+ * @note lock-free, as each buffer is only written by its own thread (and is published with a release store)
+ * @param name name of the span (which must outlive the tracing, e.g. a string literal)
+ * @param start time at which the span started
+ * @param end time at which the span ended
+ * @param arg index of the span, or -1 if it has none
+ */
+void Tracer::record(const char *name, Clock::time_point start, Clock::time_point end, long long arg) {
+    Buffer *buffer = local();
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+
+    // spans that started before the tracing are cut at its start
+    if (start < origin) start = origin;
+
+    Event &event = buffer->events[head % TRACE_CAPACITY];
+    event.name = name;
+    event.arg = arg;
+    event.start = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count();
+    event.duration = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief writes the spans of every thread to a file, in the Chrome trace event format (one complete event per span,
+ * along with the name of each thread)
+ * @note should be called once the runs are over, as the spans that are overwritten while the file is written may be
+ * torn
+ * @complexity O(T * TRACE_CAPACITY), where T is the number of threads that recorded any span
+ * @param path path to the file
+ * @return 'true' if the file was written, 'false' otherwise
+ */
+bool Tracer::dump(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    int pid = (int) getpid();
+    bool first = true;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+    for (Buffer *buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        if (!head) continue;
+
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",", pid, buffer->id, buffer->name);
+        first = false;
+
+        // only the newest spans are left once the buffer wraps around
+        for (uint64_t i = (head > TRACE_CAPACITY) ? head - TRACE_CAPACITY : 0; i < head; ++i) {
+            const Event &event = buffer->events[i % TRACE_CAPACITY];
+
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"solver\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,"
+                          "\"dur\":%.3f", event.name, pid, buffer->id, (double) event.start / 1e3,
+                    (double) event.duration / 1e3);
+
+            if (event.arg >= 0) fprintf(file, ",\"args\":{\"index\":%lld}", event.arg);
+            fputc('}', file);
+        }
+    }
+
+    fputs("\n]}\n", file);
+
+    bool failed = ferror(file);
+    return (fclose(file) == 0) && !failed;
+}
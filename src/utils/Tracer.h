@@ -0,0 +1,106 @@
+#ifndef DA_PROJ2_TRACER_H
+#define DA_PROJ2_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// number of spans kept by each thread (once it fills up, the oldest ones are overwritten)
+#define TRACE_CAPACITY (1 << 16)
+
+/*
+ * timeline of the solver phases: while tracing is on, each thread records its spans (a name, given as a string
+ * literal, a start, a duration and an optional index) into its own ring buffer, without any locks, and the spans of
+ * every thread are written as a Chrome trace (which can be opened in chrome://tracing or ui.perfetto.dev) on request;
+ * like the Profiler, building without PROFILING removes every TRACE_SCOPE statement
+ */
+
+class Tracer {
+/* ATTRIBUTES */
+public:
+    typedef std::chrono::steady_clock Clock;
+
+private:
+    struct Event {
+        const char *name;
+        long long arg;              // -1 if the span has no index
+        uint64_t start, duration;   // in nanoseconds, since the tracing started
+    };
+
+    struct Buffer {
+        std::atomic<bool> owned;    // indicates if a running thread is writing to the buffer
+        std::atomic<uint64_t> head; // number of spans ever written to the buffer
+        int id;
+        char name[32];
+        Event events[TRACE_CAPACITY];
+        Buffer *next;
+    };
+
+    static std::atomic<Buffer *> buffers;
+    static std::atomic<int> threads;
+    static std::atomic<bool> tracing;
+    static Clock::time_point origin;
+
+public:
+    class Span {
+    private:
+        const char *name;
+        long long arg;
+        Clock::time_point start;
+        bool active;
+
+    public:
+        /**
+         * @brief starts a span, if tracing is on
+         * @param name name of the span (which must outlive the tracing, e.g. a string literal)
+         * @param arg index of the span (e.g. of the row or the replica), or -1 if it has none
+         */
+        explicit Span(const char *name, long long arg = -1)
+            : name(name), arg(arg), active(enabled()) {
+            if (active) start = Clock::now();
+        }
+
+        /**
+         * @brief ends the span, recording it into the buffer of the calling thread
+         */
+        ~Span() {
+            if (active) record(name, start, Clock::now(), arg);
+        }
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+    };
+
+/* METHODS */
+private:
+    static std::string &threadName();
+    static Buffer *local();
+
+public:
+    /**
+     * @brief indicates if tracing is on
+     * @return 'true' if the spans are being recorded, 'false' otherwise
+     */
+    static bool enabled() {
+        return tracing.load(std::memory_order_relaxed);
+    }
+
+    static void start();
+    static void stop();
+    static void nameThread(const std::string &name);
+    static void record(const char *name, Clock::time_point start, Clock::time_point end, long long arg = -1);
+    static bool dump(const std::string &path);
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#ifdef PROFILING
+// records the rest of the enclosing scope as a span, e.g. TRACE_SCOPE("evolve island", i)
+#define TRACE_SCOPE(...) Tracer::Span TRACE_CONCAT(traceSpan_, __LINE__)(__VA_ARGS__)
+#else
+#define TRACE_SCOPE(...) ((void) 0)
+#endif
+
+#endif //DA_PROJ2_TRACER_H
@@ -2,6 +2,12 @@
 #define DA_TRAINS_UTILS_HPP
 
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -97,6 +103,61 @@ public:
         time += std::to_string(milliseconds) + "ms";
         return time;
     }
+
+    /**
+     * @brief computes the 64-bit FNV-1a hash of a sequence of bytes, which may continue the hash of previous ones
+     * @complexity O(n)
+     * @param data pointer to the first byte
+     * @param size number of bytes
+     * @param h hash of the previous bytes (by default, the FNV offset basis, which starts a new hash)
+     * @return hash of the bytes
+     */
+    static uint64_t hash(const void *data, size_t size, uint64_t h = 14695981039346656037ULL) {
+        auto bytes = (const unsigned char *) data;
+
+        for (size_t i = 0; i < size; ++i) {
+            h ^= bytes[i];
+            h *= 1099511628211ULL;
+        }
+
+        return h;
+    }
+
+    /**
+     * @brief parses an integer, which must take the whole string (unlike atoi, which returns 0 for garbage)
+     * @param s string to be parsed
+     * @param value where the integer is stored (only if the string is valid)
+     * @param min least value accepted
+     * @return 'true' if the string is an integer between min and INT_MAX, 'false' otherwise
+     */
+    static bool toInt(const std::string &s, int &value, int min = INT_MIN) {
+        char *end;
+        errno = 0;
+        long result = strtol(s.c_str(), &end, 10);
+
+        if (s.empty() || *end || errno == ERANGE || result < min || result > INT_MAX) return false;
+
+        value = (int) result;
+        return true;
+    }
+
+    /**
+     * @brief parses a finite real number, which must take the whole string (unlike atof, which returns 0 for garbage)
+     * @param s string to be parsed
+     * @param value where the number is stored (only if the string is valid)
+     * @param min least value accepted
+     * @return 'true' if the string is a finite number not below min, 'false' otherwise
+     */
+    static bool toDouble(const std::string &s, double &value, double min = -HUGE_VAL) {
+        char *end;
+        errno = 0;
+        double result = strtod(s.c_str(), &end);
+
+        if (s.empty() || *end || errno == ERANGE || !std::isfinite(result) || result < min) return false;
+
+        value = result;
+        return true;
+    }
 };
 
 #endif //DA_TRAINS_UTILS_HPP
@@ -0,0 +1,85 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Check.hpp"
+#include "../src/solvers/Annealer.h"
+
+/**
+ * @brief builds the distance matrix of a complete graph whose vertices are random points of a square, apart from one
+ * missing edge (like edges_25 with one of its edges removed)
+ * @param n number of vertices
+ * @param seed seed of the random number generator
+ * @return distances between the vertices (starting at index 1), with INF for the missing edge
+ */
+static std::vector<std::vector<double>> incompleteGraph(int n, uint64_t seed) {
+    XorShift rng(seed);
+    std::vector<double> x(n + 1), y(n + 1);
+
+    for (int i = 1; i <= n; ++i) {
+        x[i] = 1e5 * rng.nextDouble();
+        y[i] = 1e5 * rng.nextDouble();
+    }
+
+    std::vector<std::vector<double>> m(n + 1, std::vector<double>(n + 1, 0));
+
+    for (int i = 1; i <= n; ++i)
+        for (int j = 1; j <= n; ++j)
+            m[i][j] = std::round(std::hypot(x[i] - x[j], y[i] - y[j]));
+
+    m[1][2] = m[2][1] = std::numeric_limits<double>::max();
+    return m;
+}
+
+/**
+ * @brief computes the length of a cycle from scratch
+ * @param matrix distance matrix
+ * @param order vertices of the cycle, in the order they are visited
+ * @return length of the cycle
+ */
+static double cycleLength(const DistanceMatrix &matrix, const std::vector<int> &order) {
+    double length = 0;
+
+    for (size_t i = 0; i < order.size(); ++i)
+        length += matrix(order[i], order[(i + 1) % order.size()]);
+
+    return length;
+}
+
+/**
+ * @brief anneals a tour that starts out using the missing edge, and checks that the best length it reports is the
+ * exact length of the best tour (which no longer uses the missing edge)
+ * @param seed seed of the graph and of the annealer
+ */
+static void bestLengthIsExact(uint64_t seed) {
+    const int n = 25;
+
+    DistanceMatrix matrix;
+    matrix.build([seed]() { return incompleteGraph(n, seed); });
+
+    std::vector<int> order;
+    for (int v = 1; v <= n; ++v)
+        order.push_back(v);
+
+    Annealer annealer(matrix, order, seed);
+    double temperature = annealer.sampleTemperature(1000, 0.5);
+
+    for (int round = 0; round < 200; ++round, temperature *= 0.95)
+        for (int k = 0; k < 1000; ++k)
+            annealer.step(temperature);
+
+    const std::vector<int> &best = annealer.getBestOrder();
+    double exact = cycleLength(matrix, best);
+
+    CHECK(std::isfinite(annealer.getBestLength()));
+    CHECK(!DistanceMatrix::isMissing(exact));
+    CHECK(std::fabs(annealer.getBestLength() - exact) <= 1e-6 * exact);
+    CHECK(!DistanceMatrix::isMissing(annealer.getLength()));
+}
+
+int main() {
+    for (uint64_t seed = 1; seed <= 10; ++seed)
+        bestLengthIsExact(seed);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+#ifndef DA_PROJ2_CHECK_HPP
+#define DA_PROJ2_CHECK_HPP
+
+#include <iostream>
+
+// number of checks that have failed so far (which is also the exit status of the test)
+static int failures = 0;
+
+// reports a failed check, along with where it is, without stopping the test
+#define CHECK(condition)                                                                               \
+    do {                                                                                               \
+        if (!(condition)) {                                                                            \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": check failed: " << #condition << std::endl; \
+            ++failures;                                                                                \
+        }                                                                                              \
+    } while (0)
+
+#endif //DA_PROJ2_CHECK_HPP
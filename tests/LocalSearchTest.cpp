@@ -0,0 +1,87 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Check.hpp"
+#include "../src/network/ArrayTour.h"
+#include "../src/solvers/Candidates.h"
+#include "../src/solvers/LocalSearch.h"
+#include "../src/utils/Random.hpp"
+
+/**
+ * @brief builds the distance matrix of a complete graph whose vertices are random points of a square, apart from the
+ * edges between 2i - 1 and 2i, which are missing (so that the tour that visits the vertices in order uses n / 2 of
+ * them)
+ * @param n number of vertices
+ * @param seed seed of the random number generator
+ * @return distances between the vertices (starting at index 1), with INF for the missing edges
+ */
+static std::vector<std::vector<double>> incompleteGraph(int n, uint64_t seed) {
+    XorShift rng(seed);
+    std::vector<double> x(n + 1), y(n + 1);
+
+    for (int i = 1; i <= n; ++i) {
+        x[i] = 1e5 * rng.nextDouble();
+        y[i] = 1e5 * rng.nextDouble();
+    }
+
+    std::vector<std::vector<double>> m(n + 1, std::vector<double>(n + 1, 0));
+
+    for (int i = 1; i <= n; ++i)
+        for (int j = 1; j <= n; ++j)
+            m[i][j] = std::round(std::hypot(x[i] - x[j], y[i] - y[j]));
+
+    for (int i = 1; i + 1 <= n; i += 2)
+        m[i][i + 1] = m[i + 1][i] = std::numeric_limits<double>::max();
+
+    return m;
+}
+
+/**
+ * @brief optimizes, with 2-opt, a tour that starts out using missing edges, and checks that the length it returns is
+ * the exact length of the optimized tour, which no longer uses any of them (and stays exact when the tour is optimized
+ * again, from that length)
+ * @param n number of vertices
+ * @param seed seed of the graph
+ */
+static void lengthIsExact(int n, uint64_t seed) {
+    DistanceMatrix matrix;
+    matrix.build([n, seed]() { return incompleteGraph(n, seed); });
+
+    std::vector<std::vector<int>> candidates = Candidates::nearest(matrix, n - 1);
+    LocalSearch search(matrix, candidates);
+
+    std::vector<int> order;
+    for (int v = 1; v <= n; ++v)
+        order.push_back(v);
+
+    ArrayTour tour(order);
+    CHECK(DistanceMatrix::isMissing(search.length(tour)));
+
+    search.activateAll();
+    double length = search.twoOpt(tour, search.length(tour));
+    double exact = search.length(tour);
+
+    CHECK(!DistanceMatrix::isMissing(length));
+    CHECK(std::fabs(length - exact) <= 1e-6 * exact);
+
+    // a tour with no missing edges is updated incrementally, which must also stay exact
+    tour.reverse(tour.at(1), tour.at(n / 2));
+    double kicked = search.length(tour);
+
+    if (!DistanceMatrix::isMissing(kicked)) {
+        search.activateAll();
+        length = search.twoOpt(tour, kicked);
+
+        CHECK(std::fabs(length - search.length(tour)) <= 1e-6 * length);
+    }
+}
+
+int main() {
+    for (uint64_t seed = 1; seed <= 10; ++seed) {
+        lengthIsExact(8, seed);
+        lengthIsExact(50, seed);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Check.hpp"
+#include "../src/network/ArrayTour.h"
+#include "../src/network/TwoLevelTour.h"
+#include "../src/utils/Random.hpp"
+
+/**
+ * @brief checks that a TwoLevelTour holds the same cycle as an ArrayTour
+ * @note either of them may reverse the complementary path instead of the given one, which yields the same cycle in the
+ * opposite direction, so the TwoLevelTour is compared in whichever direction it is traversed
+ * @param reference ArrayTour that holds the expected cycle
+ * @param tour TwoLevelTour to be checked
+ * @param rng random number generator, which picks the triples of vertices whose order is compared
+ */
+static void compare(const ArrayTour &reference, const TwoLevelTour &tour, XorShift &rng) {
+    int n = reference.size();
+    bool forward = tour.next(1) == reference.next(1);
+
+    for (int v = 1; v <= n; ++v) {
+        CHECK(tour.next(v) == (forward ? reference.next(v) : reference.prev(v)));
+        CHECK(tour.prev(v) == (forward ? reference.prev(v) : reference.next(v)));
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int a = rng.nextInt(n) + 1, b = rng.nextInt(n) + 1, c = rng.nextInt(n) + 1;
+        CHECK(tour.between(a, b, c) == (forward ? reference.between(a, b, c) : reference.between(c, b, a)));
+    }
+
+    std::vector<int> expected = reference.toVector(1);
+    if (!forward) std::reverse(expected.begin() + 1, expected.end());
+
+    CHECK(tour.toVector(1) == expected);
+}
+
+/**
+ * @brief applies random reversals (the 2-opt moves) to a TwoLevelTour and to an ArrayTour, which is simple enough to
+ * be trusted, checking after each of them that both still hold the same tour (including after the TwoLevelTour has
+ * split its segments enough times to be rebuilt)
+ * @param n number of vertices
+ * @param reversals number of reversals
+ * @param seed seed of the random number generator
+ */
+static void randomReversals(int n, int reversals, uint64_t seed) {
+    XorShift rng(seed);
+
+    std::vector<int> order;
+    for (int v = 1; v <= n; ++v)
+        order.push_back(v);
+
+    // start from a random tour, so that the vertices are not in storage order
+    for (int i = n - 1; i > 0; --i)
+        std::swap(order[i], order[rng.nextInt(i + 1)]);
+
+    ArrayTour reference(order);
+    TwoLevelTour tour(order);
+
+    compare(reference, tour, rng);
+
+    for (int i = 0; i < reversals && !failures; ++i) {
+        int from = rng.nextInt(n) + 1, to = rng.nextInt(n) + 1;
+
+        // the path from 'from' to 'to' of the TwoLevelTour goes from 'to' to 'from' in the ArrayTour if they are
+        // traversed in opposite directions
+        if (tour.next(1) == reference.next(1)) reference.reverse(from, to);
+        else reference.reverse(to, from);
+
+        tour.reverse(from, to);
+
+        compare(reference, tour, rng);
+    }
+}
+
+/**
+ * @brief applies random reversals and exchanges to a marked ArrayTour and checks that rolling them back returns to the
+ * exact same tour (which is how the iterated local search undoes a rejected kick)
+ * @param n number of vertices
+ * @param rounds number of times the tour is changed and rolled back
+ * @param seed seed of the random number generator
+ */
+static void rollback(int n, int rounds, uint64_t seed) {
+    XorShift rng(seed);
+
+    std::vector<int> order;
+    for (int v = 1; v <= n; ++v)
+        order.push_back(v);
+
+    ArrayTour tour(order);
+    tour.mark();
+
+    for (int round = 0; round < rounds && !failures; ++round) {
+        std::vector<int> expected = tour.toVector(tour.at(0));
+
+        for (int change = rng.nextInt(10); change >= 0; --change) {
+            if (rng.nextInt(2)) tour.reverse(rng.nextInt(n) + 1, rng.nextInt(n) + 1);
+            else {
+                int i = rng.nextInt(n - 1), j = i + 1 + rng.nextInt(n - i - 1);
+                tour.exchange(i, j, j + 1 + rng.nextInt(n - j));
+            }
+        }
+
+        // keep some of the changes, as the search does with an improving kick
+        if (rng.nextInt(4)) tour.rollback();
+        else {
+            tour.mark();
+            continue;
+        }
+
+        CHECK(tour.toVector(tour.at(0)) == expected);
+    }
+}
+
+int main() {
+    randomReversals(2, 20, 1);
+    randomReversals(3, 50, 2);
+    randomReversals(10, 500, 3);
+    randomReversals(100, 2000, 4);
+    randomReversals(1000, 2000, 5);
+
+    rollback(2, 50, 6);
+    rollback(10, 500, 7);
+    rollback(1000, 500, 8);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "../src/network/Place.hpp"
+#include "../src/network/TSPGraph.h"
+#include "../src/utils/Random.hpp"
+#include "../src/utils/Reader.h"
+
+using std::cerr;
+using std::endl;
+using std::string;
+
+// bounding box of mainland Portugal, where the places are generated
+#define MIN_LATITUDE 37.0
+#define MAX_LATITUDE 42.1
+#define MIN_LONGITUDE (-9.5)
+#define MAX_LONGITUDE (-6.2)
+
+// size of the buffer of each output file
+#define BUFFER_SIZE (1 << 20)
+
+struct Options {
+    int vertices = 1000;
+    string kind = "uniform";    // uniform, clustered or real
+    string format = "csv";      // csv, nodes or binary
+    int degree = -1;            // random edges per vertex (0 writes the complete graph, -1 uses the default)
+    int clusters = 0;           // 0 uses the default
+    uint64_t seed = 1;
+    bool header = true;
+    string output;
+};
+
+/**
+ * @brief prints the command-line options of the generator
+ * @param out stream where the options will be printed
+ */
+static void usage(std::ostream &out) {
+    out << "Usage: generator [options] OUTPUT" << endl << endl
+        << "Generates a random TSP instance (deterministically, for a given seed) in one of the formats read by"
+        << endl << "DA_Proj2. The places are generated in mainland Portugal and the distances are great-circle ones."
+        << endl << endl
+        << "Options:" << endl
+        << "  -n, --vertices N       number of vertices (default: 1000)" << endl
+        << "  -k, --kind KIND        uniform (default), clustered (around --clusters centers) or real (towns of" << endl
+        << "                         decreasing size, along with scattered places)" << endl
+        << "  -f, --format FORMAT    csv (an edges file, like the Extra_Fully_Connected_Graphs, default)," << endl
+        << "                         nodes (a directory with nodes.csv and edges.csv, like the Real-Graphs)" << endl
+        << "                         or binary (.bin)" << endl
+        << "  -d, --degree K         random edges per vertex, where 0 writes the complete graph (default: 0 for" << endl
+        << "                         csv and 4 otherwise, as the missing distances are computed from the coordinates)"
+        << endl
+        << "  -c, --clusters C       number of clusters or towns (default: the square root of the vertices)" << endl
+        << "  -s, --seed SEED        seed of the generator (default: 1, while 0 picks a random one)" << endl
+        << "      --no-header        do not write a header in the CSV files" << endl
+        << "  -h, --help             show this message" << endl;
+}
+
+/**
+ * @brief generates a normally distributed number, using the Box-Muller transform (rather than
+ * std::normal_distribution, whose output differs between standard libraries)
+ * @param rng random number generator
+ * @return number drawn from the standard normal distribution
+ */
+static double nextGaussian(XorShift &rng) {
+    double u = 1 - rng.nextDouble();
+    return std::sqrt(-2 * std::log(u)) * std::cos(2 * M_PI * rng.nextDouble());
+}
+
+/**
+ * @brief generates the places of the instance
+ * @param options options of the generator
+ * @param rng random number generator
+ * @return places of the instance
+ */
+static std::vector<Place> generatePlaces(const Options &options, XorShift &rng) {
+    auto uniform = [&rng]() {
+        return Place(MIN_LATITUDE + (MAX_LATITUDE - MIN_LATITUDE) * rng.nextDouble(),
+                     MIN_LONGITUDE + (MAX_LONGITUDE - MIN_LONGITUDE) * rng.nextDouble());
+    };
+
+    std::vector<Place> places;
+    places.reserve(options.vertices);
+
+    if (options.kind == "uniform") {
+        while ((int) places.size() < options.vertices)
+            places.push_back(uniform());
+
+        return places;
+    }
+
+    int clusters = options.clusters ? options.clusters : std::max(1, (int) std::sqrt(options.vertices));
+
+    std::vector<Place> centers;
+    std::vector<double> weights, spreads;
+
+    // the towns of a real-like instance follow Zipf's law, and the larger ones also spread further
+    for (int i = 0; i < clusters; ++i) {
+        centers.push_back(uniform());
+        weights.push_back(options.kind == "real" ? 1.0 / (i + 1) : 1.0);
+        spreads.push_back(options.kind == "real" ? 0.1 * std::sqrt(weights.back()) : 0.05);
+    }
+
+    for (int i = 1; i < clusters; ++i)
+        weights[i] += weights[i - 1];
+
+    while ((int) places.size() < options.vertices) {
+        // a fifth of the places of a real-like instance are scattered
+        if (options.kind == "real" && rng.nextInt(5) == 0) {
+            places.push_back(uniform());
+            continue;
+        }
+
+        double target = weights.back() * rng.nextDouble();
+        auto c = (int) (std::upper_bound(weights.begin(), weights.end(), target) - weights.begin());
+        c = std::min(c, clusters - 1);
+
+        double latitude = centers[c].getLatitude() + spreads[c] * nextGaussian(rng);
+        double longitude = centers[c].getLongitude() + spreads[c] * nextGaussian(rng);
+
+        places.emplace_back(std::min(std::max(latitude, MIN_LATITUDE), MAX_LATITUDE),
+                            std::min(std::max(longitude, MIN_LONGITUDE), MAX_LONGITUDE));
+    }
+
+    return places;
+}
+
+/**
+ * @brief generates the edges of the instance, calling a function for each one
+ * @param options options of the generator
+ * @param places places of the instance
+ * @param rng random number generator
+ * @param emit function called with the source, destination (starting at 0) and weight of each edge
+ */
+template <typename F>
+static void generateEdges(const Options &options, const std::vector<Place> &places, XorShift &rng, F emit) {
+    int n = (int) places.size();
+
+    auto weight = [&places](int i, int j) {
+        return std::round(10 * TSPGraph::haversine(places[i], places[j])) / 10;
+    };
+
+    if (!options.degree) {
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j)
+                emit(i, j, weight(i, j));
+
+        return;
+    }
+
+    for (int i = 0; i < n && n > 1; ++i)
+        for (int k = 0; k < options.degree; ++k) {
+            int j = rng.nextInt(n - 1);
+            if (j >= i) ++j;
+
+            emit(i, j, weight(i, j));
+        }
+}
+
+/**
+ * @brief opens a file for writing, with a large buffer
+ * @param path path to the file
+ * @return pointer to the file (nullptr if it could not be opened)
+ */
+static FILE *openOutput(const string &path) {
+    FILE *file = fopen(path.c_str(), "wb");
+
+    if (!file) cerr << "Could not open '" << path << "'." << endl;
+    else setvbuf(file, nullptr, _IOFBF, BUFFER_SIZE);
+
+    return file;
+}
+
+/**
+ * @brief writes the edges of the instance as CSV
+ * @param path path to the file
+ * @param options options of the generator
+ * @param places places of the instance
+ * @param rng random number generator
+ * @return 'true' if the file was written, 'false' otherwise
+ */
+static bool writeEdges(const string &path, const Options &options, const std::vector<Place> &places, XorShift &rng) {
+    FILE *file = openOutput(path);
+    if (!file) return false;
+
+    if (options.header) fputs("origem,destino,distancia\n", file);
+
+    generateEdges(options, places, rng, [file](int src, int dest, double weight) {
+        fprintf(file, "%d,%d,%.1f\n", src, dest, weight);
+    });
+
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief writes the places of the instance as CSV
+ * @param path path to the file
+ * @param options options of the generator
+ * @param places places of the instance
+ * @return 'true' if the file was written, 'false' otherwise
+ */
+static bool writeNodes(const string &path, const Options &options, const std::vector<Place> &places) {
+    FILE *file = openOutput(path);
+    if (!file) return false;
+
+    if (options.header) fputs("id,longitude,latitude\n", file);
+
+    for (size_t i = 0; i < places.size(); ++i)
+        fprintf(file, "%zu,%.6f,%.6f\n", i, places[i].getLongitude(), places[i].getLatitude());
+
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief writes the instance as a binary graph (see BinaryHeader)
+ * @param path path to the file
+ * @param options options of the generator
+ * @param places places of the instance
+ * @param rng random number generator
+ * @return 'true' if the file was written, 'false' otherwise
+ */
+static bool writeBinary(const string &path, const Options &options, const std::vector<Place> &places,
+                        XorShift &rng) {
+    FILE *file = openOutput(path);
+    if (!file) return false;
+
+    BinaryHeader header = {};
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.hasCoordinates = 1;
+    header.vertices = places.size();
+
+    // the number of edges is only known at the end, so the header is written again afterwards
+    fwrite(&header, sizeof(header), 1, file);
+
+    for (const Place &place : places) {
+        double coordinates[2] = {place.getLatitude(), place.getLongitude()};
+        fwrite(coordinates, sizeof(double), 2, file);
+    }
+
+    generateEdges(options, places, rng, [file, &header](int src, int dest, double weight) {
+        BinaryEdge edge = {src, dest, weight};
+        fwrite(&edge, sizeof(edge), 1, file);
+        ++header.edges;
+    });
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+
+    bool failed = ferror(file);
+    return (fclose(file) == 0) && !failed;
+}
+
+/**
+ * @brief parses the command-line arguments
+ * @param argc number of arguments
+ * @param argv arguments (the first one being the name of the program)
+ * @param options Options where the arguments will be stored
+ * @return 'true' if the arguments are valid, 'false' otherwise
+ */
+static bool parse(int argc, char *argv[], Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "-h" || arg == "--help") {
+            usage(std::cout);
+            exit(0);
+        }
+        else if ((arg == "-n" || arg == "--vertices") && hasValue) options.vertices = atoi(argv[++i]);
+        else if ((arg == "-k" || arg == "--kind") && hasValue) options.kind = argv[++i];
+        else if ((arg == "-f" || arg == "--format") && hasValue) options.format = argv[++i];
+        else if ((arg == "-d" || arg == "--degree") && hasValue) options.degree = atoi(argv[++i]);
+        else if ((arg == "-c" || arg == "--clusters") && hasValue) options.clusters = atoi(argv[++i]);
+        else if ((arg == "-s" || arg == "--seed") && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--no-header") options.header = false;
+        else if (!arg.empty() && arg[0] == '-') {
+            cerr << "Invalid option '" << arg << "'." << endl << endl;
+            usage(cerr);
+
+            return false;
+        }
+        else options.output = arg;
+    }
+
+    bool valid = !options.output.empty() && options.vertices > 0 && options.degree >= -1 && options.clusters >= 0
+                 && (options.kind == "uniform" || options.kind == "clustered" || options.kind == "real")
+                 && (options.format == "csv" || options.format == "nodes" || options.format == "binary");
+
+    if (!valid) usage(cerr);
+    if (options.degree == -1) options.degree = (options.format == "csv") ? 0 : 4;
+
+    return valid;
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!parse(argc, argv, options)) return 1;
+
+    // the places and the edges are drawn from separate generators, so the places do not depend on the degree
+    XorShift placesRng(options.seed), edgesRng(Utils::hash(&options.seed, sizeof(options.seed)));
+    std::vector<Place> places = generatePlaces(options, placesRng);
+
+    bool written;
+
+    if (options.format == "csv") written = writeEdges(options.output, options, places, edgesRng);
+    else if (options.format == "binary") written = writeBinary(options.output, options, places, edgesRng);
+    else {
+        mkdir(options.output.c_str(), 0755);
+
+        written = writeNodes(options.output + "/nodes.csv", options, places)
+                  && writeEdges(options.output + "/edges.csv", options, places, edgesRng);
+    }
+
+    return written ? 0 : 1;
+}